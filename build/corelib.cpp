@@ -0,0 +1,461 @@
+// Generated by 'tools/embed.cpp', don't edit it.
+#include <corelib.hpp>
+
+static const char source1[] =
+	"#include \"libmod.hpl\"\012"
+	"\012"
+	"struct country {\012"
+	"    string tag\012"
+	"    string name\012"
+	"    int capital\012"
+	"    string oob\012"
+	"}\012"
+	"\012"
+	"struct rgb {\012"
+	"    int r, g, b\012"
+	"}\012"
+	"\012"
+	"country newCountry(string tag, string name, rgb color, int capital, string oob = \"\") {\012"
+	"    string path = HPL_currentMod.path\012"
+	"\012"
+	"    createFolder(f\"{path}/common/country_tags\")\012"
+	"\011createFolder(f\"{path}/common/countries\")\012"
+	"    createFolder(f\"{path}/history/countries\")\012"
+	"\012"
+	"    createFile(f\"{path}/common/countries/{tag}.txt\", f\"graphical_culture = commonwealth_gfx\\ngraphical_culture_2d = commonwealth_2d\\n\\n{tag} = {\\n\\trgb { {color.r} {color.g} {color.b} }\\n\\tcolor_ui { {color.r} {color.g} {color.b} }\\n}\")\012"
+	"    createFile(f\"{path}/history/countries/{tag} - {name}.txt\", f\"capital = {capital}\\noob = \\\"{oob}\\\"\\n\\nset_research_slots = 3\\nset_stability = 0.5\\nset_war_support = 0.5\\nset_convoys = 50\\n\\nset_popularities = {\\n\\tdemocratic = 25\\n\\tcommunism = 25\\n\\tfascism = 25\\n\\tneutrality = 25\\n}\\n\\nset_politics = {\\n\\truling_party = neutrality\\n\\tlast_election = \\\"1933.1.1\\\"\\n\\telectrion_frequency = 48\\n\\telections_allowed = no\\n}\")\012"
+	"\012"
+	"    return {tag, name, capital, oob}\012"
+	"}\012"
+	"\012"
+	"\012"
+	"int countrySetPolitics(country c, string rulingParty, int democratic, int communist, int fascist, int neutral, int electionFrequency = 0, string lastElection = \"1933.1.1\", bool electionsAllowed = false) {\012"
+	"    string path = HPL_currentMod.path\012"
+	"    string history = f\"{path}/history/countries/{c.tag} - {c.name}.txt\"\012"
+	"    string elect = replaceAll(str = replaceAll(str(electionsAllowed), \"false\", \"no\"), oldString = \"true\", newString = \"yes\")\012"
+	"\012"
+	"    writeToMultipleLines(history, 10, 13, f\"\\tdemocratic = {democratic}\\n\\tcommunism = {communist}\\n\\tfascism = {fascist}\\n\\tneutrality = {neutral}\\n\")\012"
+	"    writeToMultipleLines(history, 17, 20, f\"\\truling_party = {rulingParty}\\n\\tlast_election = {lastElection}\\n\\telection_frequency = {electionFrequency}\\n\\telections_allowed = {elect}\\n\")\012"
+	"\012"
+	"    return 0\012"
+	"}\012"
+	"\012"
+	"\012"
+	"int countrySetMisc(country c, int stability = 50, int warSupport = 50, int researchSlots = 3, int convoys = 0) {\012"
+	"    string path = HPL_currentMod.path\012"
+	"    string history = f\"{path}/history/countries/{c.tag} - {c.name}.txt\"\012"
+	"    float s = stability\012"
+	"    float w = warSupport\012"
+	"\012"
+	"    s *= 0.01\012"
+	"    w *= 0.01\012"
+	"\012"
+	"    writeToMultipleLines(history, 4, 7, f\"set_research_slots = {researchSlots}\\nset_stability = {s}\\nset_war_support = {w}\\nset_convoys = {convoys}\\n\")\012"
+	"\012"
+	"    return 0\012"
+	"}\012"
+	"// setFlag";
+
+static const char cache1[] =
+	"HPLC\005\000\000\000\011\000\000\000HPL 0.2.6\\t\357~_\031\247vS\011\000\000\000\000\000\0005\000\000\000\006\000\000\000\000\001\000\000\000\001\000\000\000\024\000\000\000\012"
+	"\000\000\000libmod.hpl\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\002\003\000\000\000\027\000\000\000P\000\000\000\007\000\000\000country\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\004\000\000\000\007\004\000\000\000,\000\000\000\012"
+	"\000\000\000\000\000\000\000\006\000\000\000string\000\000\000\000\001\000\000\000\003\000\000\000tag\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\005\000\000\000;\000\000\000\013\000\000\000\000\000\000\000\006\000\000\000string\000\000\000\000\001\000\000\000\004\000\000\000name\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\006\000\000\000K\000\000\000\013\000\000\000\000\000\000\000\003\000\000\000int\000\000\000\000\001\000\000\000\007\000\000\000capital\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\007\000\000\000[\000\000\000\012"
+	"\000\000\000\000\000\000\000\006\000\000\000string\000\000\000\000\001\000\000\000\003\000\000\000oob\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\002\012"
+	"\000\000\000i\000\000\000\036\000\000\000\003\000\000\000rgb\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\001\000\000\000\007\013\000\000\000z\000\000\000\013\000\000\000\000\000\000\000\003\000\000\000int\000\000\000\000\003\000\000\000\001\000\000\000r\001\000\000\000g\001\000\000\000b\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\003\016\000\000\000\211\000\000\000\310\003\000\000\012"
+	"\000\000\000newCountry\007\000\000\000country\000\000\000\000\000\000\000\000\000\000\000\000\005\000\000\000\006\000\000\000string\003\000\000\000tag\000\006\000\000\000string\004\000\000\000name\000\003\000\000\000rgb\005\000\000\000color\000\003\000\000\000int\007\000\000\000capital\000\006\000\000\000string\003\000\000\000oob\001\000\000\000\000\004\000\000\000\000\000\000\000\000\000\000\000\001\336\000\000\000s\003\000\000\000\003\034\000\000\000T\004\000\000\034\003\000\000\022\000\000\000countrySetPolitics\003\000\000\000int\000\000\000\000\000\000\000\000\000\000\000\000\011\000\000\000\007\000\000\000country\001\000\000\000c\000\006\000\000\000string\013\000\000\000rulingParty\000\003\000\000\000int\012"
+	"\000\000\000democratic\000\003\000\000\000int\011\000\000\000communist\000\003\000\000\000int\007\000\000\000fascist\000\003\000\000\000int\007\000\000\000neutral\000\003\000\000\000int\021\000\000\000electionFrequency\001\001\000\000\0000\006\000\000\000string\014\000\000\000lastElection\001\010\000\000\0001933.1.1\004\000\000\000bool\020\000\000\000electionsAllowed\001\005\000\000\000false\006\000\000\000\000\000\000\000\000\000\000\000\001\037\005\000\000Q\002\000\000\000\003(\000\000\000s\007\000\000\325\001\000\000\016\000\000\000countrySetMisc\003\000\000\000int\000\000\000\000\000\000\000\000\000\000\000\000\005\000\000\000\007\000\000\000country\001\000\000\000c\000\003\000\000\000int\011\000\000\000stability\001\002\000\000\00050\003\000\000\000int\012"
+	"\000\000\000warSupport\001\002\000\000\00050\003\000\000\000int\015\000\000\000researchSlots\001\001\000\000\0003\003\000\000\000int\007\000\000\000convoys\001\001\000\000\0000\001\000\000\000\000\000\000\000\000\000\000\000\001\342\007\000\000f\001\000\000\000>+\233DkV:\332";
+
+static const char source2[] =
+	"#include <libmod.hpl>\012"
+	"\012"
+	"\012"
+	"string addPoliticalPower(string tag, int value) {\012"
+	"    if HPL_SCOPE_MODE == false {\012"
+	"        HPL_throwError(\"Cannot use a scope function in non-scope mode.\")\012"
+	"    }\012"
+	"\012"
+	"    return f\"{tag} = { add_political_power = {value} }\"\012"
+	"}\012"
+	"\012"
+	"\012"
+	"string addWarSupport(string tag, int value) {\012"
+	"    float res = value\012"
+	"    res /= 100\012"
+	"\012"
+	"    if HPL_SCOPE_MODE == false {\012"
+	"        HPL_throwError(\"Cannot use a scope function in non-scope mode.\")\012"
+	"    }\012"
+	"\012"
+	"    return f\"{tag} = { add_war_support = {res} }\"\012"
+	"}\012"
+	"\012"
+	"string addStability(string tag, int value) {\012"
+	"    float res = value\012"
+	"    res /= 100\012"
+	"\012"
+	"    if HPL_SCOPE_MODE == false {\012"
+	"        HPL_throwError(\"Cannot use a scope function in non-scope mode.\")\012"
+	"    }\012"
+	"\012"
+	"    return f\"{tag} = { add_stability  = {res} }\"\012"
+	"}\012"
+	"\012"
+	"\012"
+	"string addThreat(int threat = 0, string title = \"\") {\012"
+	"    bool named = len(title)\012"
+	"    string res = f\"add_threat = {threat}\"\012"
+	"\012"
+	"    if HPL_SCOPE_MODE == false {\012"
+	"        HPL_throwError(\"Cannot use a scope function in non-scope mode.\")\012"
+	"    }\012"
+	"\012"
+	"    if len(HPL_currentMod.path) == 0 {\012"
+	"        HPL_throwError(\"Must initialize a mod via 'newMod' before using this function (path to the mod is requested to create files).\")\012"
+	"    }\012"
+	"\012"
+	"    if named {\012"
+	"        createFolder(f\"{HPL_currentMod.path}/localisation\")\012"
+	"        createFile(f\"{HPL_currentMod.path}/localisation/hpl_effect_localisation_l_english.yml\", \"l_english:\", true)\012"
+	"        writeFile(path = f\"{HPL_currentMod.path}/localisation/hpl_effect_localisation_l_english.yml\", content = f\"\\n\\tEFFECT_{HPL_locCount}:0 \\\"{title}\\\"\", mode = \"a\")\012"
+	"        res = f\"add_named_threat = { threat = {threat} name = EFFECT_{HPL_locCount} }\"\012"
+	"\012"
+	"        HPL_locCount++\012"
+	"    }\012"
+	"\012"
+	"    return res\012"
+	"}\012"
+	"\012"
+	"\012"
+	"string addCoreOf(int stateId, string tag) {\012"
+	"    if HPL_SCOPE_MODE == false {\012"
+	"        HPL_throwError(\"Cannot use a scope function in non-scope mode.\")\012"
+	"    }\012"
+	"\012"
+	"    return f\"{stateId} = { add_core_of = {tag} }\"\012"
+	"}\012"
+	"\012"
+	"\012"
+	"string annexCountry(string tag, bool transferTroops = false) {\012"
+	"    if HPL_SCOPE_MODE == false {\012"
+	"        HPL_throwError(\"Cannot use a scope function in non-scope mode.\")\012"
+	"    }\012"
+	"\012"
+	"    string value = \"no\"\012"
+	"    if transferTroops == true {\012"
+	"        value = \"yes\"\012"
+	"    }\012"
+	"\012"
+	"    return f\"annex_country = { target  = {tag} transfer_troops = {value} }\"\012"
+	"}\012"
+	"\012"
+	"\012"
+	"string countryEvent(string id, int days = -1, int hours = -1, int randomHours = -1, int randomDays = -1) {\012"
+	"    if HPL_SCOPE_MODE == false {\012"
+	"        HPL_throwError(\"Cannot use a scope function in non-scope mode.\")\012"
+	"    }\012"
+	"\012"
+	"    string buffer = f\"country_event = { id = {id} \"\012"
+	"    if days > -1 {\012"
+	"        buffer += f\"days = {days} \"\012"
+	"    }\012"
+	"    if hours > -1 {\012"
+	"        buffer += f\"hours = {hours} \"\012"
+	"    }\012"
+	"    if randomHours > -1 {\012"
+	"        buffer += f\"random_hours = {randomHours} \"\012"
+	"    }\012"
+	"    if randomDays > -1 {\012"
+	"        buffer += f\"random_days = {randomDays} \"\012"
+	"    }\012"
+	"    buffer += \"}\"\012"
+	"\012"
+	"    return buffer\012"
+	"}\012"
+	"\012"
+	"\012"
+	"string newsEvent(string id, int days = -1, int hours = -1, int randomHours = -1, int randomDays = -1) {\012"
+	"    if HPL_SCOPE_MODE == false {\012"
+	"        HPL_throwError(\"Cannot use a scope function in non-scope mode.\")\012"
+	"    }\012"
+	"\012"
+	"    string buffer = countryEvent(id, days, hours, randomHours, randomDays)\012"
+	"    buffer = replaceAll(buffer, \"country_event\", \"news_event\")\012"
+	"\012"
+	"    return buffer\012"
+	"}\012"
+	"\012"
+	"\012"
+	"string customEffectTooltip(string text) {\012"
+	"    if HPL_SCOPE_MODE == false {\012"
+	"        HPL_throwError(\"Cannot use a scope function in non-scope mode.\")\012"
+	"    }\012"
+	"\012"
+	"    if len(HPL_currentMod.path) == 0 {\012"
+	"        HPL_throwError(\"Must initialize a mod via 'newMod' before using this function (path to the mod is requested to create files).\")\012"
+	"    }\012"
+	"\012"
+	"    string res = f\"custom_effect_tooltip = EFFECT_{HPL_locCount}\"\012"
+	"\012"
+	"    createFolder(f\"{HPL_currentMod.path}/localisation\")\012"
+	"    createFile(f\"{HPL_currentMod.path}/localisation/hpl_effect_localisation_l_english.yml\", \"l_english:\", true)\012"
+	"    writeFile(f\"{HPL_currentMod.path}/localisation/hpl_effect_localisation_l_english.yml\", f\"\\n\\tEFFECT_{HPL_locCount}:0 \\\"{text}\\\"\", \"a\")\012"
+	"\012"
+	"    HPL_locCount++\012"
+	"\012"
+	"    return res\012"
+	"}\012"
+	"\012"
+	"\012"
+	"string setCountryFlag(string flag, int days = -1, int value = -1) {\012"
+	"    if HPL_SCOPE_MODE == false {\012"
+	"        HPL_throwError(\"Cannot use a scope function in non-scope mode.\")\012"
+	"    }\012"
+	"    string buffer = f\"set_country_flag = {flag}\"\012"
+	"\012"
+	"    if days > 0 || value > 0 {\012"
+	"        buffer = f\"set_country_flag = { flag = {flag} \"\012"
+	"\012"
+	"        if days > 0 {\012"
+	"            buffer += f\"days = {days} \"\012"
+	"        }\012"
+	"        if value > 0 {\012"
+	"            buffer += f\"value = {value} \"\012"
+	"        }\012"
+	"        buffer += \"}\"\012"
+	"    }\012"
+	"\012"
+	"    return buffer\012"
+	"}\012";
+
+static const char cache2[] =
+	"HPLC\005\000\000\000\011\000\000\000HPL 0.2.6s\234\362\3256\343 \007j\021\000\000\000\000\000\000\240\000\000\000\013\000\000\000\000\001\000\000\000\001\000\000\000\024\000\000\000\012"
+	"\000\000\000libmod.hpl\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\001\003\004\000\000\000\030\000\000\000\334\000\000\000\021\000\000\000addPoliticalPower\006\000\000\000string\000\000\000\000\000\000\000\000\000\000\000\000\002\000\000\000\006\000\000\000string\003\000\000\000tag\000\003\000\000\000int\005\000\000\000value\000\002\000\000\000\000\000\000\000\000\000\000\000\001H\000\000\000\254\000\000\000\000\003\015\000\000\000\367\000\000\000\370\000\000\000\015\000\000\000addWarSupport\006\000\000\000string\000\000\000\000\000\000\000\000\000\000\000\000\002\000\000\000\006\000\000\000string\003\000\000\000tag\000\003\000\000\000int\005\000\000\000value\000\002\000\000\000\000\000\000\000\000\000\000\000\001#\001\000\000\314\000\000\000\000\003\030\000\000\000\361\001\000\000\366\000\000\000\014\000\000\000addStability\006\000\000\000string\000\000\000\000\000\000\000\000\000\000\000\000\002\000\000\000\006\000\000\000string\003\000\000\000tag\000\003\000\000\000int\005\000\000\000value\000\002\000\000\000\000\000\000\000\000\000\000\000\001\034\002\000\000\313\000\000\000\000\003$\000\000\000\352\002\000\000\221\003\000\000\011\000\000\000addThreat\006\000\000\000string\000\000\000\000\000\000\000\000\000\000\000\000\002\000\000\000\003\000\000\000int\006\000\000\000threat\001\001\000\000\0000\006\000\000\000string\005\000\000\000title\001\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\001\036\003\000\000]\003\000\000\000\003=\000\000\000~\006\000\000\320\000\000\000\011\000\000\000addCoreOf\006\000\000\000string\000\000\000\000\000\000\000\000\000\000\000\000\002\000\000\000\003\000\000\000int\007\000\000\000stateId\000\006\000\000\000string\003\000\000\000tag\000\002\000\000\000\000\000\000\000\000\000\000\000\001\250\006\000\000\246\000\000\000\000\003F\000\000\000Q\007\000\000R\001\000\000\014\000\000\000annexCountry\006\000\000\000string\000\000\000\000\000\000\000\000\000\000\000\000\002\000\000\000\006\000\000\000string\003\000\000\000tag\000\004\000\000\000bool\016\000\000\000transferTroops\001\005\000\000\000false\001\000\000\000\000\000\000\000\000\000\000\000\001\216\007\000\000\025\001\000\000\000\003T\000\000\000\246\010\000\000V\002\000\000\014\000\000\000countryEvent\006\000\000\000string\000\000\000\000\000\000\000\000\000\000\000\000\005\000\000\000\006\000\000\000string\002\000\000\000id\000\003\000\000\000int\004\000\000\000days\001\002\000\000\000-1\003\000\000\000int\005\000\000\000hours\001\002\000\000\000-1\003\000\000\000int\013\000\000\000randomHours\001\002\000\000\000-1\003\000\000\000int\012"
+	"\000\000\000randomDays\001\002\000\000\000-1\001\000\000\000\000\000\000\000\000\000\000\000\001\017\011\000\000\355\001\000\000\000\003l\000\000\000\377\012"
+	"\000\000w\001\000\000\011\000\000\000newsEvent\006\000\000\000string\000\000\000\000\000\000\000\000\000\000\000\000\005\000\000\000\006\000\000\000string\002\000\000\000id\000\003\000\000\000int\004\000\000\000days\001\002\000\000\000-1\003\000\000\000int\005\000\000\000hours\001\002\000\000\000-1\003\000\000\000int\013\000\000\000randomHours\001\002\000\000\000-1\003\000\000\000int\012"
+	"\000\000\000randomDays\001\002\000\000\000-1\001\000\000\000\000\000\000\000\000\000\000\000\001e\013\000\000\021\001\000\000\000\003x\000\000\000y\014\000\000\354\002\000\000\023\000\000\000customEffectTooltip\006\000\000\000string\000\000\000\000\000\000\000\000\000\000\000\000\001\000\000\000\006\000\000\000string\004\000\000\000text\000\001\000\000\000\000\000\000\000\000\000\000\000\001\241\014\000\000\304\002\000\000\000\003\215\000\000\000h\017\000\000\001\002\000\000\016\000\000\000setCountryFlag\006\000\000\000string\000\000\000\000\000\000\000\000\000\000\000\000\003\000\000\000\006\000\000\000string\004\000\000\000flag\000\003\000\000\000int\004\000\000\000days\001\002\000\000\000-1\003\000\000\000int\005\000\000\000value\001\002\000\000\000-1\001\000\000\000\000\000\000\000\000\000\000\000\001\252\017\000\000\277\001\000\000\000\021\177\215\022\266:\034\006";
+
+static const char source3[] =
+	"#include \"libmod.hpl\"\012"
+	"\012"
+	"\012"
+	"struct event {\012"
+	"\011string namespace\012"
+	"\012"
+	"\011int id\012"
+	"\011string title\012"
+	"\011string description\012"
+	"\011string picture\012"
+	"\011bool isTriggeredOnly\012"
+	"\011bool isNewsEvent\012"
+	"\012"
+	"\011bool init = false\012"
+	"\011int options = 0\012"
+	"}\012"
+	"\012"
+	"\012"
+	"event newEvent(string namespace, int id, string title, string description, string imagePath, bool isTriggeredOnly = true, scope immediate = {}) {\012"
+	"\011string path = HPL_currentMod.path\012"
+	"\012"
+	"\011string locPath = f\"{path}/localisation/hpl_events_l_english.yml\"\012"
+	"\011string eventPath = f\"{path}/events/{namespace}.txt\"\012"
+	"\011string gfxName = imagePath\012"
+	"\012"
+	"\011if find(gfxName, \"GFX_\") == false {\012"
+	"\011\011gfxName = \"GFX_\" + replaceAll(replaceAll(getFilenameFromPath(imagePath), \".\", \"_\"), \"/\", \"_\")\012"
+	"\012"
+	"\011\011createFolder(f\"{path}/gfx/event_pictures\")\012"
+	"\011\011createFolder(f\"{path}/interface\")\012"
+	"\011}\012"
+	"\012"
+	"\011string eventContent = f\"\\n\\n# \\\"{title}\\\" event\\ncountry_event = {\\n\\tid = {namespace}.{id}\\n\\ttitle = {namespace}.{id}.t\\n\\tdesc = {namespace}.{id}.d\\n\\tpicture = {gfxName}\"\012"
+	"\011if isTriggeredOnly {\012"
+	"\011\011eventContent += \"\\n\\n\\tis_triggered_only = yes\"\012"
+	"\011}\012"
+	"\011if len(immediate) != 0 {\012"
+	"\011\011string scopeResult = replaceAll(str(immediate), \"\\n\", \"\\n\\t\\t\")\012"
+	"\011\011eventContent += f\"\\n\\n\\timmediate = {\\n\\t\\t{scopeResult}\\n\\t}\"\012"
+	"\011}\012"
+	"\012"
+	"\011createFolder(f\"{path}/events\")\012"
+	"\011createFolder(f\"{path}/localisation\")\012"
+	"\012"
+	"\011createFile(eventPath, f\"add_namespace = {namespace}\")\012"
+	"\011createFile(locPath, \"l_english:\", true)\012"
+	"\012"
+	"\011writeFile(eventPath, f\"{eventContent}\\n\\t\\n\\n}\", \"a\")\012"
+	"\012"
+	"\011writeLocalisation(locPath, f\"{namespace}.{id}.t\", title)\012"
+	"\011writeLocalisation(locPath, f\"{namespace}.{id}.d\", description)\012"
+	"\012"
+	"\011if find(imagePath, \"GFX_\") == false {\012"
+	"\011\011string ddsName = replaceAll(replaceAll(getFilenameFromPath(imagePath), \".jpg\", \".dds\"), \".png\", \".dds\")\012"
+	"\012"
+	"\011\011createFile(f\"{path}/interface/hpl_eventpictures.gfx\", \"spriteTypes = {\")\012"
+	"\012"
+	"\011\011convertToDds(imagePath, f\"{path}/gfx/event_pictures/{ddsName}\")\012"
+	"\011\011writeFile(f\"{path}/interface/hpl_eventpictures.gfx\", f\"\\n\\nspriteType = {\\n\\tname = \\\"GFX_{gfxName}\\\"\\n\\ttexturefile = \\\"gfx/event_pictures/{ddsName}\\\"\\n}\", \"a\")\012"
+	"\011}\012"
+	"\012"
+	"\011return {namespace, id, title, description, imagePath}\012"
+	"}\012"
+	"\012"
+	"\012"
+	"int newEventOption(event e, string title, scope result = {}) {\012"
+	"\011string path = HPL_currentMod.path\012"
+	"\011string scopeResult\012"
+	"\012"
+	"\011if len(result) != 0 {\012"
+	"\011\011scopeResult += \"\\n\\t\\t\"\012"
+	"\011\011scopeResult += replaceAll(str(result), \"\\n\", \"\\n\\t\\t\")\012"
+	"\011}\012"
+	"\012"
+	"\011string locPath = f\"{path}/localisation/hpl_events_l_english.yml\"\012"
+	"\011string eventPath = f\"{path}/events/{e.namespace}.txt\"\012"
+	"\012"
+	"\011writeToLine(eventPath, -3, f\"\\n\\toption = {\\n\\t\\tname = {e.namespace}.{e.id}.1{scopeResult}\\n\\t}\")\012"
+	"\011writeLocalisation(locPath, f\"{e.namespace}.{e.id}.1\", title)\012"
+	"\011e.options++\012"
+	"\012"
+	"\011return 0\012"
+	"}";
+
+static const char cache3[] =
+	"HPLC\005\000\000\000\011\000\000\000HPL 0.2.6EB\220y\345\270\246\017\376\011\000\000\000\000\000\000S\000\000\000\004\000\000\000\000\001\000\000\000\001\000\000\000\024\000\000\000\012"
+	"\000\000\000libmod.hpl\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\002\004\000\000\000\030\000\000\000\252\000\000\000\005\000\000\000event\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\011\000\000\000\007\005\000\000\000(\000\000\000\020\000\000\000\000\000\000\000\006\000\000\000string\000\000\000\000\001\000\000\000\011\000\000\000namespace\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\007\000\000\000;\000\000\000\006\000\000\000\000\000\000\000\003\000\000\000int\000\000\000\000\001\000\000\000\002\000\000\000id\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\010\000\000\000C\000\000\000\014\000\000\000\000\000\000\000\006\000\000\000string\000\000\000\000\001\000\000\000\005\000\000\000title\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\011\000\000\000Q\000\000\000\022\000\000\000\000\000\000\000\006\000\000\000string\000\000\000\000\001\000\000\000\013\000\000\000description\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\012"
+	"\000\000\000e\000\000\000\016\000\000\000\000\000\000\000\006\000\000\000string\000\000\000\000\001\000\000\000\007\000\000\000picture\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\013\000\000\000u\000\000\000\024\000\000\000\000\000\000\000\004\000\000\000bool\000\000\000\000\001\000\000\000\017\000\000\000isTriggeredOnly\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\014\000\000\000\213\000\000\000\020\000\000\000\000\000\000\000\004\000\000\000bool\000\000\000\000\001\000\000\000\013\000\000\000isNewsEvent\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\016\000\000\000\236\000\000\000\021\000\000\000\000\000\000\000\004\000\000\000bool\000\000\000\000\001\000\000\000\004\000\000\000init\001\000\000\000\005\005\000\000\000false\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\017\000\000\000\261\000\000\000\017\000\000\000\000\000\000\000\003\000\000\000int\000\000\000\000\001\000\000\000\007\000\000\000options\001\000\000\000\004\001\000\000\0000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\003\023\000\000\000\305\000\000\000\034\007\000\000\010\000\000\000newEvent\005\000\000\000event\000\000\000\000\000\000\000\000\000\000\000\000\007\000\000\000\006\000\000\000string\011\000\000\000namespace\000\003\000\000\000int\002\000\000\000id\000\006\000\000\000string\005\000\000\000title\000\006\000\000\000string\013\000\000\000description\000\006\000\000\000string\011\000\000\000imagePath\000\004\000\000\000bool\017\000\000\000isTriggeredOnly\001\004\000\000\000true\005\000\000\000scope\011\000\000\000immediate\001\002\000\000\000{}\005\000\000\000\000\000\000\000\000\000\000\000\001U\001\000\000\214\006\000\000\000\003B\000\000\000\344\007\000\000\032\002\000\000\016\000\000\000newEventOption\003\000\000\000int\000\000\000\000\000\000\000\000\000\000\000\000\003\000\000\000\005\000\000\000event\001\000\000\000e\000\006\000\000\000string\005\000\000\000title\000\005\000\000\000scope\006\000\000\000result\001\002\000\000\000{}\002\000\000\000\000\000\000\000\000\000\000\000\001!\010\000\000\335\001\000\000\000\037b\355\277V\323\2326";
+
+static const char source4[] =
+	"#read once\015\012"
+	"\015\012"
+	"struct modTags {\015\012"
+	"    bool alternativeHistory = false\015\012"
+	"    bool balance = false\015\012"
+	"    bool events = false\015\012"
+	"    bool fixes = false\015\012"
+	"    bool gameplay = false\015\012"
+	"    bool graphics = false\015\012"
+	"    bool historical = false\015\012"
+	"    bool ideologies = false\015\012"
+	"    bool map = false\015\012"
+	"    bool military = false\015\012"
+	"    bool nationalFocuses = false\015\012"
+	"    bool sound = false\015\012"
+	"    bool technologies = false\015\012"
+	"    bool translation = false\015\012"
+	"    bool utilities = false\015\012"
+	"}\015\012"
+	"\015\012"
+	"struct mod {\015\012"
+	"    string name\015\012"
+	"    string supportedVersion\015\012"
+	"    modTags tags\015\012"
+	"    string path\015\012"
+	"}\015\012"
+	"\015\012"
+	"mod HPL_currentMod\015\012"
+	"int HPL_locCount = 0\015\012"
+	"\015\012"
+	"int newMod(string path, string name, string supportedVersion, modTags tags = {}) {\015\012"
+	"    HPL_currentMod = {name, supportedVersion, tags, f\"{path}/{name}\"}\015\012"
+	"    removeFolder(path)\015\012"
+	"    createFolder(HPL_currentMod.path)\015\012"
+	"\015\012"
+	"    string descriptor = f\"name = \\\"{name}\\\"\\nsupported_version = \\\"{supportedVersion}\\\"\\ntags = {\"\015\012"
+	"    if tags.alternativeHistory {\015\012"
+	"        descriptor += \"\\n\\t\\\"Gameplay\\\"\"\015\012"
+	"    }\015\012"
+	"    if tags.balance {\015\012"
+	"        descriptor += \"\\n\\t\\\"Balance\\\"\"\015\012"
+	"    }\015\012"
+	"    if tags.events {\015\012"
+	"        descriptor += \"\\n\\t\\\"Events\\\"\"\015\012"
+	"    }\015\012"
+	"    descriptor += \"\\n}\"\015\012"
+	"    string modDescriptor = f\"{descriptor}\\npath = \\\"mod/{name}\\\"\"\015\012"
+	"\015\012"
+	"    createFile(f\"{path}/{name}.mod\", modDescriptor)\015\012"
+	"    createFile(f\"{path}/{name}/descriptor.mod\", descriptor)\015\012"
+	"\015\012"
+	"    return 0\015\012"
+	"}\015\012"
+	"\015\012"
+	"\015\012"
+	"//int moveToModsFolder(mod m) {\015\012"
+	"//\015\012"
+	"//}";
+
+static const char cache4[] =
+	"HPLC\005\000\000\000\011\000\000\000HPL 0.2.6\360\000\010b\015\214\214\"\207\005\000\000\000\000\000\000:\000\000\000\006\000\000\000\001\001\000\000\000\001\000\000\000\011\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\002\003\000\000\000\016\000\000\000\267\001\000\000\007\000\000\000modTags\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\017\000\000\000\007\004\000\000\000$\000\000\000\037\000\000\000\000\000\000\000\004\000\000\000bool\000\000\000\000\001\000\000\000\022\000\000\000alternativeHistory\001\000\000\000\005\005\000\000\000false\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\005\000\000\000I\000\000\000\024\000\000\000\000\000\000\000\004\000\000\000bool\000\000\000\000\001\000\000\000\007\000\000\000balance\001\000\000\000\005\005\000\000\000false\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\006\000\000\000c\000\000\000\023\000\000\000\000\000\000\000\004\000\000\000bool\000\000\000\000\001\000\000\000\006\000\000\000events\001\000\000\000\005\005\000\000\000false\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\007\000\000\000|\000\000\000\022\000\000\000\000\000\000\000\004\000\000\000bool\000\000\000\000\001\000\000\000\005\000\000\000fixes\001\000\000\000\005\005\000\000\000false\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\010\000\000\000\224\000\000\000\025\000\000\000\000\000\000\000\004\000\000\000bool\000\000\000\000\001\000\000\000\010\000\000\000gameplay\001\000\000\000\005\005\000\000\000false\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\011\000\000\000\257\000\000\000\025\000\000\000\000\000\000\000\004\000\000\000bool\000\000\000\000\001\000\000\000\010\000\000\000graphics\001\000\000\000\005\005\000\000\000false\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\012"
+	"\000\000\000\312\000\000\000\027\000\000\000\000\000\000\000\004\000\000\000bool\000\000\000\000\001\000\000\000\012"
+	"\000\000\000historical\001\000\000\000\005\005\000\000\000false\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\013\000\000\000\347\000\000\000\027\000\000\000\000\000\000\000\004\000\000\000bool\000\000\000\000\001\000\000\000\012"
+	"\000\000\000ideologies\001\000\000\000\005\005\000\000\000false\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\014\000\000\000\004\001\000\000\020\000\000\000\000\000\000\000\004\000\000\000bool\000\000\000\000\001\000\000\000\003\000\000\000map\001\000\000\000\005\005\000\000\000false\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\015\000\000\000\032\001\000\000\025\000\000\000\000\000\000\000\004\000\000\000bool\000\000\000\000\001\000\000\000\010\000\000\000military\001\000\000\000\005\005\000\000\000false\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\016\000\000\0005\001\000\000\034\000\000\000\000\000\000\000\004\000\000\000bool\000\000\000\000\001\000\000\000\017\000\000\000nationalFocuses\001\000\000\000\005\005\000\000\000false\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\017\000\000\000W\001\000\000\022\000\000\000\000\000\000\000\004\000\000\000bool\000\000\000\000\001\000\000\000\005\000\000\000sound\001\000\000\000\005\005\000\000\000false\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\020\000\000\000o\001\000\000\031\000\000\000\000\000\000\000\004\000\000\000bool\000\000\000\000\001\000\000\000\014\000\000\000technologies\001\000\000\000\005\005\000\000\000false\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\021\000\000\000\216\001\000\000\030\000\000\000\000\000\000\000\004\000\000\000bool\000\000\000\000\001\000\000\000\013\000\000\000translation\001\000\000\000\005\005\000\000\000false\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\022\000\000\000\254\001\000\000\026\000\000\000\000\000\000\000\004\000\000\000bool\000\000\000\000\001\000\000\000\011\000\000\000utilities\001\000\000\000\005\005\000\000\000false\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\002\025\000\000\000\311\001\000\000`\000\000\000\003\000\000\000mod\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\004\000\000\000\007\026\000\000\000\333\001\000\000\013\000\000\000\000\000\000\000\006\000\000\000string\000\000\000\000\001\000\000\000\004\000\000\000name\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\027\000\000\000\354\001\000\000\027\000\000\000\000\000\000\000\006\000\000\000string\000\000\000\000\001\000\000\000\020\000\000\000supportedVersion\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\030\000\000\000\011\002\000\000\014\000\000\000\000\000\000\000\007\000\000\000modTags\000\000\000\000\001\000\000\000\004\000\000\000tags\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\031\000\000\000\033\002\000\000\013\000\000\000\000\000\000\000\006\000\000\000string\000\000\000\000\001\000\000\000\004\000\000\000path\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\034\000\000\000-\002\000\000\022\000\000\000\000\000\000\000\003\000\000\000mod\000\000\000\000\001\000\000\000\016\000\000\000HPL_currentMod\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\007\035\000\000\000A\002\000\000\024\000\000\000\000\000\000\000\003\000\000\000int\000\000\000\000\001\000\000\000\014\000\000\000HPL_locCount\001\000\000\000\004\001\000\000\0000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\003\037\000\000\000Y\002\000\000\000\003\000\000\006\000\000\000newMod\003\000\000\000int\000\000\000\000\000\000\000\000\000\000\000\000\004\000\000\000\006\000\000\000string\004\000\000\000path\000\006\000\000\000string\004\000\000\000name\000\006\000\000\000string\020\000\000\000supportedVersion\000\007\000\000\000modTags\004\000\000\000tags\001\002\000\000\000{}\003\000\000\000\000\000\000\000\000\000\000\000\001\252\002\000\000\257\002\000\000\000\374\271\212\233Vi?;";
+
+static const char source5[] =
+	"// Mod structure.\015\012"
+	"#include \"libmod.hpl\"\015\012"
+	"\015\012"
+	"// General functions in scopes.\015\012"
+	"#include \"libeffects.hpl\"\015\012"
+	"#include \"libtriggers.hpl\"\015\012"
+	"\015\012"
+	"// Separate modding implementations.\015\012"
+	"#include \"libcountry.hpl\"\015\012"
+	"#include \"libevent.hpl\"";
+
+static const char cache5[] =
+	"HPLC\005\000\000\000\011\000\000\000HPL 0.2.6\325\322\333\361%\320?\240\336\000\000\000\000\000\000\000\012"
+	"\000\000\000\005\000\000\000\000\002\000\000\000\024\000\000\000\024\000\000\000\012"
+	"\000\000\000libmod.hpl\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\005\000\000\000N\000\000\000\030\000\000\000\016\000\000\000libeffects.hpl\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\006\000\000\000i\000\000\000\031\000\000\000\017\000\000\000libtriggers.hpl\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\011\000\000\000\255\000\000\000\030\000\000\000\016\000\000\000libcountry.hpl\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\012"
+	"\000\000\000\310\000\000\000\026\000\000\000\014\000\000\000libevent.hpl\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\000\340d\253\332m\004\250N";
+
+static const char source6[] =
+	"string isOwnedBy(auto subScope, string tag) {\012"
+	"    if HPL_SCOPE_MODE == false {\012"
+	"        HPL_throwError(\"Cannot use a scope function in non-scope mode.\")\012"
+	"    }\012"
+	"\012"
+	"    return f\"{subScope} = { is_owned_by = {tag} }\"\012"
+	"}\012"
+	"\012"
+	"\012"
+	"string hasDlc(string dlc) {\012"
+	"    if HPL_SCOPE_MODE == false {\012"
+	"        HPL_throwError(\"Cannot use a scope function in non-scope mode.\")\012"
+	"    }\012"
+	"\012"
+	"    return f\"has_dlc = \\\"{dlc}\\\"\"\012"
+	"}\012"
+	"\012"
+	"\012"
+	"string countryExists(string tag) {\012"
+	"    if HPL_SCOPE_MODE == false {\012"
+	"        HPL_throwError(\"Cannot use a scope function in non-scope mode.\")\012"
+	"    }\012"
+	"\012"
+	"    return f\"country_exists = {tag}\"\012"
+	"}\012"
+	"\012"
+	"\012"
+	"string hasWar(string tag) {\012"
+	"    if HPL_SCOPE_MODE == false {\012"
+	"        HPL_throwError(\"Cannot use a scope function in non-scope mode.\")\012"
+	"    }\012"
+	"\012"
+	"    return f\"{tag} = { has_war = yes }\"\012"
+	"}";
+
+static const char cache6[] =
+	"HPLC\005\000\000\000\011\000\000\000HPL 0.2.6\230\257T\227\271\352\002$\374\002\000\000\000\000\000\000\"\000\000\000\004\000\000\000\003\001\000\000\000\000\000\000\000\323\000\000\000\011\000\000\000isOwnedBy\006\000\000\000string\000\000\000\000\000\000\000\000\000\000\000\000\002\000\000\000\004\000\000\000auto\010\000\000\000subScope\000\006\000\000\000string\003\000\000\000tag\000\002\000\000\000\000\000\000\000\000\000\000\000\001,\000\000\000\247\000\000\000\000\003\012"
+	"\000\000\000\326\000\000\000\260\000\000\000\006\000\000\000hasDlc\006\000\000\000string\000\000\000\000\000\000\000\000\000\000\000\000\001\000\000\000\006\000\000\000string\003\000\000\000dlc\000\001\000\000\000\000\000\000\000\000\000\000\000\001\360\000\000\000\226\000\000\000\000\003\023\000\000\000\211\001\000\000\272\000\000\000\015\000\000\000countryExists\006\000\000\000string\000\000\000\000\000\000\000\000\000\000\000\000\001\000\000\000\006\000\000\000string\003\000\000\000tag\000\001\000\000\000\000\000\000\000\000\000\000\000\001\252\001\000\000\231\000\000\000\000\003\034\000\000\000F\002\000\000\266\000\000\000\006\000\000\000hasWar\006\000\000\000string\000\000\000\000\000\000\000\000\000\000\000\000\001\000\000\000\006\000\000\000string\003\000\000\000tag\000\001\000\000\000\000\000\000\000\000\000\000\000\001`\002\000\000\234\000\000\000\000P\322\371\315ttj2";
+
+const HPL::coreLibrary HPL::coreLibraries[] = {
+	{"libcountry.hpl", {source1, sizeof(source1) - 1}, {cache1, sizeof(cache1) - 1}},
+	{"libeffects.hpl", {source2, sizeof(source2) - 1}, {cache2, sizeof(cache2) - 1}},
+	{"libevent.hpl", {source3, sizeof(source3) - 1}, {cache3, sizeof(cache3) - 1}},
+	{"libmod.hpl", {source4, sizeof(source4) - 1}, {cache4, sizeof(cache4) - 1}},
+	{"libpdx.hpl", {source5, sizeof(source5) - 1}, {cache5, sizeof(cache5) - 1}},
+	{"libtriggers.hpl", {source6, sizeof(source6) - 1}, {cache6, sizeof(cache6) - 1}},
+	{}
+};
+const size_t HPL::coreLibraryCount = 6;
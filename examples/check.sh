@@ -0,0 +1,194 @@
+#!/bin/sh
+# Checks the behaviour that's easy to break without noticing, run it with 'make check'.
+# Usage: examples/check.sh [path to hpl]
+
+cd "$(dirname "$0")/.."
+HPL=${1:-build/hpl}
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+failed=0
+
+fail() {
+	echo "FAIL: $1"
+	failed=1
+}
+
+# Runs the interpreter without its 'Finished interpreting' lines, so only what the script printed is left.
+run() {
+	{ "$HPL" "$@" 2>&1; } 2>/dev/null | grep -v "Finished interpreting"
+}
+
+# Runs a script on both engines and checks that it stops with the error.
+expectError() {
+	printf '%s\n' "$1" > "$TMP/error.hpl"
+
+	for engine in "" "-vm"; do
+		run $engine "$TMP/error.hpl" | grep -qF "$2" || fail "'hpl${engine:+ $engine}' didn't stop with \"$2\" on: $1"
+	done
+}
+
+# Runs a script on both engines and checks what it printed.
+expectOutput() {
+	printf '%s\n' "$1" > "$TMP/output.hpl"
+
+	for engine in "" "-vm"; do
+		[ "$(run $engine "$TMP/output.hpl")" = "$2" ] || fail "'hpl${engine:+ $engine}' didn't print \"$2\" on: $1"
+	done
+}
+
+
+# Examples with an 'output.txt' have to print exactly that, with the tree-walker and with the VM.
+for dir in examples/*/; do
+	[ -f "$dir/output.txt" ] || continue
+
+	for engine in "" "-vm"; do
+		run $engine "$dir/main.hpl" > "$TMP/out.txt"
+		cmp -s "$TMP/out.txt" "$dir/output.txt" || fail "${dir%/}: 'hpl${engine:+ $engine}' didn't print what's in output.txt"
+	done
+done
+
+
+# Caches: an included file that changed has to be parsed again, and a damaged cache has to be ignored.
+printf 'int libValue = 1\n' > "$TMP/lib.hpl"
+printf '#include "lib.hpl"\nprint(libValue)\n' > "$TMP/main.hpl"
+
+[ "$(run "$TMP/main.hpl")" = "1" ] || fail "cache: first run"
+[ -f "$TMP/lib.hplc" ] || fail "cache: the include's cache wasn't saved"
+cp "$TMP/lib.hplc" "$TMP/old.hplc"
+
+printf 'int libValue = 2\n' > "$TMP/lib.hpl"
+[ "$(run "$TMP/main.hpl")" = "2" ] || fail "cache: the edited include was loaded from its old cache"
+cmp -s "$TMP/lib.hplc" "$TMP/old.hplc" && fail "cache: the include's cache wasn't rebuilt"
+
+size=$(wc -c < "$TMP/lib.hplc")
+printf 'X' | dd of="$TMP/lib.hplc" bs=1 seek=$((size - 12)) conv=notrunc 2>/dev/null
+[ "$(run "$TMP/main.hpl")" = "2" ] || fail "cache: a damaged cache was used"
+
+
+# Snapshots: the second run restores the include instead of interpreting it, until the include is edited.
+printf 'int libValue = 1\n' > "$TMP/lib.hpl"
+"$HPL" -snapshot "$TMP/main.hpl" > /dev/null 2>&1
+[ -f "$TMP/main.hpls" ] || fail "snapshot: it wasn't saved"
+cp "$TMP/main.hpls" "$TMP/old.hpls"
+
+"$HPL" -snapshot "$TMP/main.hpl" > "$TMP/out.txt" 2>&1
+grep -q "lib.hpl" "$TMP/out.txt" && fail "snapshot: it wasn't restored"
+[ "$(grep -v "Finished interpreting" "$TMP/out.txt")" = "1" ] || fail "snapshot: the restored run printed something else"
+
+printf 'int libValue = 3\n' > "$TMP/lib.hpl"
+"$HPL" -snapshot "$TMP/main.hpl" > "$TMP/out.txt" 2>&1
+grep -q "lib.hpl" "$TMP/out.txt" || fail "snapshot: it was restored after the include was edited"
+[ "$(grep -v "Finished interpreting" "$TMP/out.txt")" = "3" ] || fail "snapshot: the edited include wasn't used"
+cmp -s "$TMP/main.hpls" "$TMP/old.hpls" && fail "snapshot: it wasn't made again"
+
+# Lists of structs point at their struct, which has to be restored with them.
+printf 'struct point {\n\tint x = 1\n\tstring name = "origin"\n}\npoint[] points = {{2, "two"}}\n' > "$TMP/lib.hpl"
+printf '#include "lib.hpl"\npoints += {3}\nprint(points)\n' > "$TMP/main.hpl"
+"$HPL" -snapshot "$TMP/main.hpl" > /dev/null 2>&1
+"$HPL" -snapshot "$TMP/main.hpl" > "$TMP/out.txt" 2>&1
+grep -q "lib.hpl" "$TMP/out.txt" && fail "snapshot: the list of structs wasn't restored"
+[ "$(grep -v "Finished interpreting" "$TMP/out.txt")" = '{{2, "two"}, {3, "origin"}}' ] || fail "snapshot: the restored list of structs printed something else"
+
+
+# Lists.
+expectError 'int[] a
+a += "text"' "Cannot append a string type to a list of int"
+expectError 'string[] s = {"a"}
+int[] a
+a += s' "Cannot append a string[] type to a list of int"
+expectError 'int[] a = {1, "x"}' "into a list of int"
+expectError 'int[] a = {1}
+print(a[3])' "is out of range"
+expectError 'int[] a = {1}
+print(a["x"])' "Lists can only be indexed with ints"
+expectError 'int[] a = {1}
+a -= 1' "Only '+=' is allowed for lists"
+
+
+# Maps.
+expectError 'int[string] m = {"a": 1}
+print(m["b"])' "doesn't exist (Map"
+expectError 'int[string] m = {"a": "x"}' "into a map of int"
+expectError 'int[string] m = {"a" 1}' "format is '<key>: <value>'"
+expectError 'int[string] m = {"a": 1}
+print(m[1])' "' are string-typed)"
+expectError 'int[string] m = {"a": 1}
+m[1] = 2' "' are string-typed)"
+expectError 'int x = 1
+print(x["a"])' "isn't a list or a map"
+expectError 'int x = 1
+for a in x {
+}' "Cannot go through a value that isn't a list or a map"
+
+
+# Calls: logging can't change what a program does, and every nested call counts towards the limit.
+run -vm -l examples/calls/main.hpl | grep -v "^[[:space:]]*LOG:" > "$TMP/out.txt"
+cmp -s "$TMP/out.txt" examples/calls/output.txt || fail "examples/calls: 'hpl -vm -l' didn't print what's in output.txt"
+
+expectError 'int down(int n) {
+	if n == 0 {
+		return 0
+	}
+	n -= 1
+	return down(n)
+}
+print(down(5000))' "Too many nested calls"
+
+# With a large '-maxDepth', the VM keeps going, while the tree-walker has to stop before its native stack runs out.
+printf 'int down(int n) {\n\tif n == 0 {\n\t\treturn 0\n\t}\n\tn -= 1\n\treturn down(n)\n}\nprint(down(100000))\n' > "$TMP/deep.hpl"
+[ "$(run -vm -maxDepth 1000000 "$TMP/deep.hpl")" = "0" ] || fail "'hpl -vm -maxDepth 1000000' didn't finish 'down(100000)'"
+run -maxDepth 1000000 "$TMP/deep.hpl" | grep -qF "as many as the native stack can fit" || fail "'hpl -maxDepth 1000000' didn't stop 'down(100000)' with an error"
+
+for depth in abc 0 -5 99999999999 12x; do
+	run -maxDepth $depth examples/calls/main.hpl | grep -qF "has to be followed by a whole number above 0" || fail "'-maxDepth $depth' was accepted"
+done
+run examples/calls/main.hpl -maxDepth | grep -qF "has to be followed by the number of calls" || fail "'-maxDepth' without a number was accepted"
+
+
+# Variables: a call on the right side declares variables of its own, which can't break the variable on the left side.
+expectOutput 'int f(int a) {
+	int b = 1
+	int c = 2
+	int d = 3
+	int e = 4
+	return a
+}
+int x = 1
+x += f(1)
+print(x)
+int y = 0
+y = f(2)
+print(y)
+int[] l = {1}
+l[0] += f(5)
+print(l)' "2
+2
+{6}"
+
+
+# Structs: variables share their struct's defaults, so writing to one of them can't change the others.
+expectOutput 'struct point {
+	int x = 1
+	string name = "a name that is too long to fit inside of a value"
+}
+int move(point p = {}) {
+	p.x += 10
+	return p.x
+}
+point a = {}
+point b = a
+b.x = 5
+print(move())
+print(move())
+print(a)
+print(b)' "11
+11
+{1, \"a name that is too long to fit inside of a value\"}
+{5, \"a name that is too long to fit inside of a value\"}"
+
+
+if [ $failed -eq 0 ]; then
+	echo "All checks passed"
+fi
+
+exit $failed
@@ -0,0 +1,72 @@
+/*
+* Copyright (C) 2022-2023 EimaMei/Sacode
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+*    claim that you wrote the original software. If you use this software
+*    in a product, an acknowledgment in the product documentation would be
+*    appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+*    misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*
+*
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace HPL {
+	// A bump allocator for short-lived data. Allocating only moves a pointer forward and
+	// nothing is freed on its own; instead everything after a marker is dropped at once.
+	// Its blocks are kept around, so a rewound arena doesn't touch the heap again.
+	class arena : public std::pmr::memory_resource {
+	public:
+		struct marker { size_t block; size_t used; };
+
+		// Rewinds the arena back to where it was once the scope ends. Scopes have to be
+		// nested, which they are as long as they're only used on the stack.
+		struct scope {
+			arena& owner;
+			marker start;
+
+			scope(arena& a) : owner(a), start(a.mark()) {}
+			~scope() { owner.rewind(start); }
+		};
+
+		marker mark() const { return {current, used}; }
+		void rewind(marker m) { current = m.block; used = m.used; }
+
+		size_t allocations() const { return count; } // Every allocation that was made, even the ones that got rewound.
+
+	private:
+		struct block { std::unique_ptr<char[]> data; size_t size; };
+		static constexpr size_t blockSize = 64 * 1024;
+
+		std::vector<block> blocks;
+		size_t current = 0, used = 0;
+		size_t count = 0;
+
+		void* do_allocate(size_t bytes, size_t alignment) override;
+		void do_deallocate(void*, size_t, size_t) override {} // Freed by 'rewind'.
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+	};
+
+	// Temporaries of the current statement (eg. the buffers of 'split' and the regex matches).
+	// Every statement rewinds it once it's done, so the memory gets reused by the next one.
+	extern arena scratch;
+
+	// How many times the heap was allocated from since the start.
+	size_t heapAllocations();
+}
@@ -0,0 +1,80 @@
+/*
+* Copyright (C) 2022-2023 EimaMei/Sacode
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+*    claim that you wrote the original software. If you use this software
+*    in a product, an acknowledgment in the product documentation would be
+*    appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+*    misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*
+*
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace HPL {
+	// An interned identifier or type name. Every name is only stored once for the entire
+	// process, so atoms are copied and compared as integers. The string itself is only
+	// needed for the messages and the JSON dumper.
+	class atom {
+	public:
+		// Names that get interned before any other, so their atoms are known at compile time
+		// (eg. 'var.type == atom::INT').
+		enum builtin : uint32_t { NONE, INT, FLOAT, STRING, BOOL, AUTO, STRUCT, SCOPE, VOID, RELATIONAL_OPERATOR, LOGICAL_OPERATOR, OUT_OF_ORDER, BUILTIN_COUNT };
+
+		atom() = default;
+		constexpr atom(builtin name) : id(name) {}
+		explicit atom(std::string_view text);
+		explicit atom(const std::string& text) : atom(std::string_view(text)) {}
+		explicit atom(const char* text) : atom(std::string_view(text)) {}
+
+		// Finds the name's atom without interning it, so that random strings (eg. values
+		// that might be variable names) don't fill up the table. Returns false if it doesn't exist.
+		static bool find(std::string_view text, atom& output);
+
+		const std::string& str() const;
+		operator const std::string&() const { return str(); }
+
+		const char* c_str() const { return str().c_str(); }
+		size_t size() const { return str().size(); }
+		bool empty() const { return id == 0; }
+		void clear() { id = 0; }
+
+		uint32_t index() const { return id; } // 0 is always the empty name.
+
+		friend bool operator==(atom a, atom b) { return a.id == b.id; }
+
+	private:
+		uint32_t id = 0;
+	};
+
+	// Atoms are only compared with atoms, so that a comparison never goes through the strings.
+	bool operator==(atom a, const std::string& b) = delete;
+	bool operator==(atom a, const char* b) = delete;
+
+	inline std::string operator+(const std::string& a, atom b) { return a + b.str(); }
+	inline std::string operator+(const char* a, atom b) { return a + b.str(); }
+	inline std::string operator+(atom a, const std::string& b) { return a.str() + b; }
+	inline std::string operator+(atom a, const char* b) { return a.str() + b; }
+	inline std::ostream& operator<<(std::ostream& stream, atom a) { return stream << a.str(); }
+
+	namespace literals {
+		// Interns a name that's written in the interpreter's code (eg. '"print"_atom').
+		inline atom operator""_atom(const char* text, size_t size) { return atom(std::string_view(text, size)); }
+	}
+}
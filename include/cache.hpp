@@ -0,0 +1,58 @@
+/*
+* Copyright (C) 2022-2023 EimaMei/Sacode
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+*    claim that you wrote the original software. If you use this software
+*    in a product, an acknowledgment in the product documentation would be
+*    appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+*    misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*
+*
+*/
+
+#pragma once
+
+#include <parser.hpp>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace HPL {
+	// Hashes the source with 64-bit FNV-1a.
+	uint64_t hashSource(std::string_view source);
+	// Gets the cache's path of the file ('<file>c', eg. 'core/libpdx.hplc').
+	std::string getCachePath(const std::string& file);
+
+	// Reads the parsed statements from the cache's data. Fails if the data is broken or
+	// was made from a different source or HPL version.
+	bool readCache(program& prog, std::string_view data);
+	// Writes the program's parsed statements into the cache's format.
+	std::string writeCache(const program& prog);
+
+	// Loads the already parsed statements from the program's cache. Fails if the cache
+	// doesn't exist, is broken, or was made from a different source or HPL version.
+	bool loadCache(program& prog);
+	// Saves the parsed statements into the program's cache. If the cache can't be
+	// written (eg. the folder is read-only), then nothing happens.
+	void saveCache(const program& prog);
+
+	// Gets the snapshot's path of the file ('<file>s', eg. 'main.hpls').
+	std::string getSnapshotPath(const std::string& file);
+	// Restores the variables, structs and functions that the program's prelude (the first
+	// 'prelude' statements) made from its snapshot. Fails if the prelude or any of the loaded
+	// files changed since the snapshot was saved.
+	bool loadSnapshot(const program& prog, size_t prelude);
+	// Saves the interpreter's state after the program's prelude into its snapshot.
+	void saveSnapshot(const program& prog, size_t prelude);
+}
@@ -27,9 +27,9 @@
 #define AUTHORS "Created by EimaMei/Sacode"
 
 #if defined(__clang__)
-    #define COMPILER removeFrontAndBackSpaces(std::string("Clang version ") + std::string(__clang_version__)).c_str() // mfw random space exists randomly on linux and windows.
+    #define COMPILER std::string(removeFrontAndBackSpaces(std::string("Clang version ") + std::string(__clang_version__))) // mfw random space exists randomly on linux and windows.
 #elif defined(__GNUC__) && !defined(__clang__)
-	#define COMPILER "GCC version " + __GNUC__ + "." + __GNUC_MINOR__ + "." + __GNUC_PATCHLEVEL__
+	#define COMPILER ("GCC version " + std::to_string(__GNUC__) + "." + std::to_string(__GNUC_MINOR__) + "." + std::to_string(__GNUC_PATCHLEVEL__))
 #elif __MSC_VER__
 	#define COMPILER "MSVC version" + __MSC_VER__
 #else
@@ -56,4 +56,7 @@ void checkArgs(std::vector<std::string> args, std::string input, bool& config, b
 // Prints the help.
 void printHelp();
 // Dumps the entire project's JSON.
-void dumpJson();
\ No newline at end of file
+void dumpJson();
+// Keeps a document open for editor tooling. It's opened and edited with the commands
+// from stdin, and after each one its symbols and errors get dumped as JSON.
+void serveDocument();
\ No newline at end of file
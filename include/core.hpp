@@ -20,21 +20,50 @@
 *
 */
 #include <interpreter.hpp>
+#include <parser.hpp>
 
 #include <string>
 #include <vector>
 
 
 // The core types of the language.
-extern std::vector<std::string> coreTypes;
+extern std::vector<HPL::atom> coreTypes;
+// How many arguments were given in order before the out of order ones.
+extern int startOrgAt;
 
 // Reformats the params to be turned into variables.
 // Afterwards, check what function the user specified
 // and execute it.
 int executeFunction(std::string name, std::string params, HPL::function& func, HPL::variable& output, bool dontCheck = false);
+// Same as above, except that the arguments were already parsed.
+int executeFunction(std::string name, const std::vector<HPL::expression>& args, HPL::function& func, HPL::variable& output, bool dontCheck = false);
+// How many functions are running inside of each other right now.
+extern int callDepth;
+// Remembers where the native stack begins. Calls that run on it (every call of the tree-walker)
+// stop with the same error as '-maxDepth' once the stack is nearly full, instead of crashing.
+void markStackStart();
+
+// Calls the function with the already evaluated params. If 'organizeParams'
+// is true, then the params were given out of order and their names are set.
+int callFunction(HPL::atom name, std::vector<HPL::variable>& params, bool organizeParams, HPL::function& func, HPL::variable& output, bool dontCheck = false);
+// A call of a function whose body still has to run.
+struct pendingCall {
+	int function = -1;       // Index of the function inside of 'HPL::functions', -1 if the call was already done.
+	std::string oldCurFile;  // The caller's file and line, which are restored afterwards.
+	int oldLineCount = 0;
+	size_t base = 0;         // Where the function's params begin inside of 'HPL::variables'.
+};
+// Same as 'callFunction', except that only core functions get done right away. The params of
+// any other function are declared and its body is left for the caller to run, which is finished
+// with 'endCall'. The core function's info is copied into 'coreFunction' if it isn't null.
+int beginCall(HPL::atom name, std::vector<HPL::variable>& params, bool organizeParams, pendingCall& call, HPL::variable& output, bool dontCheck = false, HPL::function* coreFunction = nullptr);
+// Removes the function's variables, restores the caller's info and sets the output.
+void endCall(pendingCall& call, HPL::variable& output);
 // Checks if the specific function got used.
-bool useFunction(HPL::function func, std::vector<HPL::variable>& userParams);
+bool useFunction(const HPL::function& func, std::vector<HPL::variable>& userParams);
 // Defines the core functions and returns the function's return if successful.
-allowedTypes coreFunctions(std::vector<HPL::variable> params);
+allowedTypes coreFunctions(std::vector<HPL::variable>& params);
 // Sets the variable's value to the return of specified function.
-int assignFuncReturnToVar(HPL::variable* existingVar, std::string funcName, std::string funcParam, bool dontCheck = false);
\ No newline at end of file
+int assignFuncReturnToVar(HPL::variable* existingVar, const HPL::expression& call, bool dontCheck = false);
+// Sets the variable's value to the function's output, which is checked against the function's type.
+int assignOutputToVar(HPL::variable* existingVar, const std::string& funcName, HPL::atom funcType, HPL::variable& output);
\ No newline at end of file
@@ -0,0 +1,39 @@
+/*
+* Copyright (C) 2022-2023 EimaMei/Sacode
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+*    claim that you wrote the original software. If you use this software
+*    in a product, an acknowledgment in the product documentation would be
+*    appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+*    misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*
+*
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace HPL {
+	// A core library that's built into the executable, so it's never read from the disk.
+	struct coreLibrary {
+		const char* name;        // Name of the file (eg. 'libpdx.hpl').
+		std::string_view source;
+		std::string_view cache;  // The already parsed statements, in the '.hplc' format.
+	};
+
+	// Generated by 'tools/embed.cpp' from the 'core' folder when HPL gets built.
+	extern const coreLibrary coreLibraries[];
+	extern const size_t coreLibraryCount;
+}
@@ -0,0 +1,72 @@
+/*
+* Copyright (C) 2022-2023 EimaMei/Sacode
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+*    claim that you wrote the original software. If you use this software
+*    in a product, an acknowledgment in the product documentation would be
+*    appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+*    misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*
+*
+*/
+
+#pragma once
+
+#include <interpreter.hpp>
+#include <parser.hpp>
+
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace HPL {
+	// An error that was found while parsing.
+	struct diagnostic {
+		int line = 0;
+		std::string message;
+	};
+
+	// A part of the document that holds one top level statement (or none, if it's only
+	// empty lines and comments), along with everything up until the next statement.
+	struct region {
+		size_t begin; // Offset inside of the document.
+		size_t size;
+		int line;     // Line where the region begins.
+
+		std::shared_ptr<const std::string> source; // Source that was parsed, which the statement's views point into. Shared with the regions that were parsed together.
+		std::vector<node> body;
+		diagnostic error;  // Why the region couldn't be parsed, the message is empty if it could.
+		int lineShift = 0; // How many lines the region moved since it was parsed, which its statements' lines don't know about.
+	};
+
+	// A file that's being edited. Only the regions that an edit touches get parsed again,
+	// so the symbols stay up to date without running or reparsing the entire file.
+	struct document {
+		std::string file;
+		std::string text;
+		std::list<region> regions;
+
+		// Symbols of the document, in the same form that the interpreter keeps them.
+		std::vector<structure> structures;
+		std::vector<function> functions;
+		std::vector<variable> variables;
+		std::vector<diagnostic> errors;
+
+		// Replaces the entire text and parses all of it.
+		void open(std::string_view newText);
+		// Replaces the text between 'begin' and 'end' and parses the regions that it touched.
+		void edit(size_t begin, size_t end, std::string_view newText);
+	};
+}
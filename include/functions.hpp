@@ -36,23 +36,26 @@
 
 // Prints something out in the terminal.
 // void print(auto msg, string end = "\n")
-void print(HPL::variable msg, std::string end = "\n");
+void print(const HPL::variable& msg, std::string end = "\n");
 
 // Converts value to str.
 // string str(auto value)
-std::string func_str(HPL::variable value);
+std::string func_str(const HPL::variable& value);
 // Converts value to int`.
 // int int(auto value)
-int func_int(HPL::variable value);
+int func_int(const HPL::variable& value);
 // Converts value to float.
 // float float(auto value)
-float func_float(HPL::variable value);
+float func_float(const HPL::variable& value);
 // Converts value to bool.
 // bool bool(auto value)
-bool func_bool(HPL::variable value);
-// Gets the length of the value
+bool func_bool(const HPL::variable& value);
+// Gets the length of the value (or the amount of elements in a list or a map)
 // int len(auto value)
-int len(HPL::variable value);
+int len(const HPL::variable& value);
+// Checks if the map has the key.
+// bool hasKey(auto map, auto key)
+bool hasKey(const HPL::variable& map, const HPL::variable& key);
 
 // Creates a folder.
 // int createFolder(string path)
@@ -21,35 +21,44 @@
 */
 #pragma once
 #include <interpreter.hpp>
+#include <parser.hpp>
 #include <vector>
 #include <string>
+#include <string_view>
 
 /* General functions. */
+// The strings are only read, so they're taken as views and nothing gets copied unless a new string is returned.
 
 // Splits the sentence each time it encounters the 'value'. If 'charScope' isn't null, then the array doesn't get split if 'value' is between 'charScope[0]' and 'charScope[1]'.
-std::vector<std::string> split(std::string str, std::string value, std::string charScope = "\0\0");
-// Checks if the line matches the regex.
-bool useRegex(std::string str, std::string regexText);
-// Checks if there are multiple matches from the regex.
-bool useIterativeRegex(std::string str, std::string regexText);
+std::vector<std::string> split(std::string_view str, std::string_view value, std::string_view charScope = "\0\0");
+// Checks if the line matches the regex. The regex only gets compiled once, and 'HPL::matches' points into 'str'.
+bool useRegex(std::string_view str, std::string_view regexText);
+// Checks if there are multiple matches from the regex. Same rules as 'useRegex' apply.
+bool useIterativeRegex(std::string_view str, std::string_view regexText);
+// Checks if the string is '<name>(<params>)', same as the regex '^\s*([^\s\(]+)\((.*)\)\s*$'. If 'wholeLine' is false, then the call can be anywhere in the string.
+bool matchFunctionCall(std::string_view str, bool wholeLine = true);
+// Finds an out of order argument ('<param> = <value>') and puts the param's name and value into 'HPL::matches'.
+bool matchNamedParam(std::string_view str);
 // Removes any whitespace in a sentence.
-std::string removeSpaces(std::string str);
-// Removes any whitespace in the front or back of a string.
-std::string removeFrontAndBackSpaces(std::string str);
-// Removes the double quotes from strings. If 'noChecks' is enabled then it doesn't check if the string has double quotes in the front and back, which just essentially removes both the front and back char for any string.
-std::string unstringify(std::string str, bool noChecks = false, char character = '"');
-// Gets the path from the filename (eg. /usr/bin/somefile.img would turn to /usr/bin).
-std::string getPathFromFilename(std::string filename);
+std::string removeSpaces(std::string_view str);
+// Removes any whitespace in the front or back of a string. The output points into 'str'.
+std::string_view removeFrontAndBackSpaces(std::string_view str);
+// Removes the double quotes from strings. If 'noChecks' is enabled then it doesn't check if the string has double quotes in the front and back, which just essentially removes both the front and back char for any string. The output points into 'str'.
+std::string_view unstringify(std::string_view str, bool noChecks = false, char character = '"');
+// Gets the path from the filename (eg. /usr/bin/somefile.img would turn to /usr/bin). The output points into 'filename'.
+std::string_view getPathFromFilename(std::string_view filename);
+// Gets the absolute path without any '.', '..' or symlinks, so that the same file always has the same path.
+std::string getCanonicalPath(const std::string& path);
 // Checks if something is in the line.
-bool find(std::string line, std::string str);
+bool find(std::string_view line, std::string_view str);
 // Checks if string is an int.
-bool isInt(std::string str);
+bool isInt(std::string_view str);
 //Checks if a string is *actually* a string or f-string.
-bool isStr(std::string str);
+bool isStr(std::string_view str);
 // Replaces all instances of 'oldString' with 'newString' in 'str'
-std::string replaceAll(std::string str, std::string oldString, std::string newString);
+std::string replaceAll(std::string_view str, std::string_view oldString, std::string_view newString);
 // Replaces the FIRST instance of 'oldString' with 'newString' in 'str'
-std::string replaceOnce(std::string, std::string oldString, std::string newString);
+std::string replaceOnce(std::string_view str, std::string_view oldString, std::string_view newString);
 // Converts a string to a bool.
 bool stringToBool(std::string str);
 // Converts a string to a float.
@@ -61,23 +70,18 @@ double eval(std::string expr, int& errorCode);
 
 // Converts 'val' to a string and return it.
 // (eg. xToStr(234) would return a string "234")
-std::string xToStr(allowedTypes val);
+std::string xToStr(const allowedTypes& val);
 // Converts 'val' to the type given and returns it.
 // (eg. xToType<int>("27") would return an int 27)
 template <class T>
-T xToType(allowedTypes val) {
+T xToType(const allowedTypes& val) {
 	if (std::is_same_v<T, int> || std::is_same_v<T, bool> || std::is_same_v<T, float>) {
-		if (std::holds_alternative<std::string>(val))
-			return (T)std::stod(std::get<std::string>(val));
-
-		else if (std::holds_alternative<int>(val))
-			return (T)std::get<int>(val);
-
-		else if (std::holds_alternative<float>(val))
-			return (T)std::get<float>(val);
-
-		else if (std::holds_alternative<bool>(val))
-			return (T)std::get<bool>(val);
+		switch (val.index()) {
+			case HPL::value::STRING: return (T)std::stod(getStr(val));
+			case HPL::value::INT: return (T)getInt(val);
+			case HPL::value::FLOAT: return (T)getFloat(val);
+			case HPL::value::BOOL: return (T)getBool(val);
+		}
 	}
 
 	return T();
@@ -87,28 +91,65 @@ T xToType(allowedTypes val) {
 
 // If a type exists. If the type is a struct, then `info` becomes
 // the pointer to the struct.
-bool typeIsValid(std::string type, HPL::structure*& info);
+bool typeIsValid(HPL::atom type, HPL::structure*& info);
 // If a type is a core type.
-bool coreTyped(std::string type);
+bool coreTyped(HPL::atom type);
+// Gets the type of the list's elements (eg. 'int' for 'int[]'), or nullptr if the type isn't a list.
+const HPL::typeInfo* getListElement(HPL::atom type);
+// Gets the type of the map's keys (eg. 'string' for 'int[string]'), or nullptr if the type isn't a map.
+const HPL::typeInfo* getMapKey(HPL::atom type);
 // Gets the core type from value. If it cannot determine the type,
 // then it's most likely a struct (or a type that doesn't exist).
-std::string getTypeFromValue(std::string value);
+HPL::atom getTypeFromValue(std::string_view value);
+// Checks if the parsed value is the operator of the given kind (eg. HPL::atom::RELATIONAL_OPERATOR).
+bool isOperator(const HPL::expression& expr, HPL::atom kind);
 // Corrects the string value and returns a `HPL::variable`, with the
 // `.type` being the value's original type, and the `.value` being
 // the inputed value in a correct type. (eg. "3" would output
 // {.type = "int", .value = 3}).
 bool setCorrectValue(HPL::variable& var, std::string value, bool onlyChangeValue);
+// Same as `setCorrectValue`, except that the value was already parsed,
+// so it doesn't have to be figured out again.
+bool evaluateExpression(HPL::variable& var, const HPL::expression& expr, bool onlyChangeValue);
 // Gets the variable's value by its name and returns a pointer of it.
 // If the `varName` is a struct member, then regardlessly it'll look
-// for said member's type and values.
-HPL::variable* getVarFromName(std::string varName);
+// for said member's type and values. Members that are going to be changed
+// need `write`, otherwise the struct's shared defaults might get returned.
+HPL::variable* getVarFromName(std::string varName, bool write = false);
+// Same as `getVarFromName`, except that the path's names and member indexes
+// are remembered inside of the access site's cache.
+HPL::variable* getVarFromName(const std::string& varName, HPL::memberCache& cache, bool write = false);
+// Finds the member of the struct variable by the cache's path. The member
+// indexes are resolved once for the variable's type. Untouched members are
+// read from the struct's defaults, unless `write` is set.
+HPL::variable* getMember(HPL::variable& var, HPL::memberCache& cache, bool write = false);
+// Points a struct variable whose members were never set to its struct's shared defaults, which doesn't copy them.
+void setStructDefaults(HPL::variable& var);
+// Turns the struct literal's members into the elements of a list (eg. when '{1, 2}' is passed as an 'int[]').
+void structToList(HPL::variable& var, HPL::atom type);
+// An element of a list or a map that an index expression (eg. 'a[i].b') points at. Only
+// the member's column gets loaded for elements that are structs, instead of the entire element.
+struct listElement {
+	const HPL::expression* source = nullptr; // The index expression, or null if nothing was found.
+	size_t index = 0;
+	int column = -1;      // Column of the member after the index, or -1 for the entire element.
+	HPL::variable value;  // Copy of the element (or the member), which gets stored back once it's edited.
+};
+// Finds the element of the index expression and returns it (or its member). Returns nullptr if the
+// list doesn't exist. Elements that are going to be changed need `write`, and `storeElement` afterwards.
+// Writing to a key that a map doesn't have yet adds it.
+HPL::variable* findElement(const HPL::expression& expr, listElement& element, bool write = false);
+// Stores the edited element back into its list or map.
+void storeElement(listElement& element);
+// Puts the strings of the value together (eg. '"a" + b + "c"').
+std::string joinStrings(const std::string& value);
 // Fixes the sentence from being f-string to a normal string.
 int getValueFromFstring(std::string ogValue, std::string& output);
 // Get the struct from name. If no struct is found, returns a nullptr.
-HPL::structure* getStructFromName(std::string name);
+HPL::structure* getStructFromName(HPL::atom name);
 // Convert math expression to an actual result (UNFINISHED).
 std::string extractMathFromValue(std::string expr, HPL::variable* var);
 // Returns a string "<type> <name>(<params>)"
 std::string printFunction(HPL::function func);
 // Returns a string "<type> <name> = [value]"
-std::string printVar(HPL::variable var);
\ No newline at end of file
+std::string printVar(const HPL::variable& var);
\ No newline at end of file
@@ -22,44 +22,38 @@
 
 #pragma once
 
+#include <atom.hpp>
+#include <value.hpp>
+
+#include <deque>
 #include <string>
+#include <string_view>
 #include <regex>
+#include <utility>
 #include <vector>
-#include <variant>
 
 #if defined(WIN32) || defined(_WIN32) || defined(__WIN32) && !defined(__CYGWIN__)
 #include <windows.h>
 #define WINDOWS 1
 #endif
 
-// Interpreter modes.
-#define MODE_DEFAULT 0
-
-#define MODE_SAVE_STRUCT          0x0001
-#define MODE_SAVE_FUNC            0x0002
-#define MODE_SAVE_SCOPE           0x0004
-#define MODE_SCOPE_IF_STATEMENT   0x0006
-#define MODE_SCOPE_IGNORE_ALL     0x0008
-
-#define MODE_CHECK_STRUCT         0x0101
-#define MODE_CHECK_FUNC           0x0102
-#define MODE_CHECK_SCOPE          0x0104
-#define MODE_CHECK_IF_STATEMENT   0x0106
-#define MODE_CHECK_IGNORE_ALL     0x0108
-
 // Outputs returns.
 #define FOUND_NOTHING 0
 #define FOUND_SOMETHING 1
 #define FOUND_ERROR -1
 
 // Get <type>.
-#define getStr(value) std::get<std::string>(value)
-#define getInt(value) std::get<int>(value)
-#define getFloat(value) std::get<float>(value)
-#define getBool(value) std::get<bool>(value)
-#define getVars(value) std::get<std::vector<HPL::variable>>(value)
+#define getStr(value) std::string((value).str())
+#define getInt(value) (value).integer()
+#define getFloat(value) (value).decimal()
+#define getBool(value) (value).boolean()
+#define getVars(value) std::as_const(value).vars() // Shared members can only be edited through `.vars()`.
+#define getList(value) std::as_const(value).items() // Same for lists and `.items()`.
+#define getMap(value) std::as_const(value).entries() // And maps with `.entries()`.
 
-#define isVars(value) std::holds_alternative<std::vector<HPL::variable>>(value)
+#define isVars(val) ((val).index() == HPL::value::VARS)
+#define isList(val) ((val).index() == HPL::value::LIST)
+#define isMap(val) ((val).index() == HPL::value::MAP)
 
 
 namespace HPL {
@@ -77,48 +71,97 @@ namespace HPL {
 		bool breakpoint; std::pair<std::string, int> breakpointValues;
 
 		bool dumpJson;
+		bool vm; // Runs the program on the bytecode VM instead of walking the statement tree.
+		bool cache = true; // Loads and saves the parsed files from/to their '.hplc' caches.
+		bool diskCore; // Reads the core libraries from the 'core' folder instead of the ones built into the executable.
+		bool snapshot; // Restores the state after the main file's includes from its '.hpls' snapshot, or saves it.
+		bool serve; // Keeps a document open for editor tooling instead of interpreting a file.
+		bool memStats; // Prints how many heap allocations were made and how many were taken by the scratch arena.
+		int maxDepth = 1000; // How many calls can run inside of each other before the program stops with an error.
 
 		std::string curIndent;
 	};
-	#define allowedTypes std::variant<std::monostate, std::string, int, float, bool, std::vector<HPL::variable>>
+	#define allowedTypes HPL::value
 
 	struct variable {
-		std::string type;
-		std::string name;
-		allowedTypes value; // Every possible type in HPL. Note that std::vector<variable> is for structs, while the std::any one is for extra data, like localisation and arrays
+		atom type;
+		atom name;
+		allowedTypes value; // Every possible type in HPL. Note that std::vector<variable> is for structs.
 
-		bool has_value() { return value.index() != 0; }
-		void reset_value() { value = std::monostate{}; }
-		void reset_all() { type = std::string(); name = std::string(); value = std::monostate{}; }
+		bool has_value() const { return value.index() != HPL::value::NOTHING; }
+		void reset_value() { value = {}; }
+		void reset_all() { type.clear(); name.clear(); value = {}; }
 	};
 	struct structure {
-		std::string name;
+		atom name;
 		std::vector<variable> value;
 		int minParamCount;
+		HPL::value defaults; // The members as a single shared value, which struct variables use until they write to one.
 	};
+	// A core type or a struct type, which gets a dense ID once it's first used as a type.
+	struct typeInfo {
+		int id;
+		atom name;
+		bool core = false;               // If it's one of 'coreTypes'.
+		structure* _struct = nullptr;    // The newest definition of the struct with the name, if there's one.
+		const typeInfo* element = nullptr; // Type of the elements if it's a list or a map (eg. 'int' for 'int[]').
+		const typeInfo* key = nullptr;     // Type of the keys if it's a map (eg. 'string' for 'int[string]').
+	};
+	struct node;
 	struct function {
-		std::string type;
-		std::string name;
+		atom type;
+		atom name;
 		std::vector<variable> params;
-		std::vector<std::string> code;
+		const node* definition = nullptr; // The parsed function, which holds the body.
 		int minParamCount;
 
 		std::string file; // Used for the error message.
 		int startingLine;
 	};
-	struct vector { // A very small "implementation" of std::smatches.
-		std::vector<std::string> value;
+	// Every variable that exists right now, from the oldest to the newest. Names are hashed, so
+	// finding a variable doesn't go through all of them. Functions and blocks remember the size
+	// that the table had before them, and only remove their own variables once they end.
+	struct variableTable {
+		std::vector<variable> values;
+		std::vector<std::vector<size_t>> indexes; // Indexes of the variables with the name, found by its atom, from the oldest.
+
+		variableTable() = default;
+		variableTable(std::vector<variable> vars) { assign(std::move(vars)); }
+
+		// Finds the oldest variable with the name, as that's the one that always gets used.
+		variable* find(atom name);
+		// Checks if a variable before 'end' has the name.
+		bool existsBefore(atom name, size_t end) const;
+
+		void push_back(variable var);
+		// Removes every variable after the first 'size' ones.
+		void resize(size_t size);
+		// Removes the block's variables, which start at 'start'. Older variables with the same
+		// name get their values, while the rest get cached for the JSON dumper.
+		void endBlock(size_t start);
+		// Replaces every variable.
+		void assign(std::vector<variable> vars);
+
+		size_t size() const { return values.size(); }
+		variable& operator[](size_t index) { return values[index]; }
+		variable& back() { return values.back(); }
+		std::vector<variable>::iterator begin() { return values.begin(); }
+		std::vector<variable>::iterator end() { return values.end(); }
+	};
+	struct vector { // A very small "implementation" of std::smatches. The captures point into the matched string, so it has to outlive them.
+		std::vector<std::string_view> value;
 
-		std::string str(int index) {
-			if (index > value.size()) return "";
+		std::string str(int index) { return std::string(view(index)); }
+		std::string_view view(int index) {
+			if (index == 0 || (size_t)index > value.size()) return {};
 
 			return value[index - 1];
 		}
 		void clear() { value.clear(); }
 		size_t size() { return value.size(); }
 		bool empty() { return value.empty(); }
-		void push_back(std::string x) { value.push_back(x); }
-		std::string operator[](int index) { return value[index]; }
+		void push_back(std::string_view x) { value.push_back(x); }
+		std::string operator[](int index) { return std::string(value[index]); }
 	};
 
 	// Interpreter configs.
@@ -126,57 +169,76 @@ namespace HPL {
 
 	// Interpreter runtime information.
 	extern std::string curFile;
-	extern std::string line;
 	extern int lineCount;
-	extern int mode;
 	extern HPL::vector matches;
-	extern int equalBrackets;
-	extern int scopeIndex;
-	extern int oldMode;
 
 	// Definitions that are saved in memory.
-	extern std::vector<variable> variables;
-	extern std::vector<structure> structures;
+	extern variableTable variables;
+	extern std::deque<structure> structures; // The newest struct is first. A deque keeps the pointers to the structs stable.
 	extern std::vector<function> functions;
-	extern std::vector<function> ifStatements;
 	extern HPL::variable functionOutput;
 
 	extern std::vector<variable> cachedVariables; // Out of scoped variables for the JSON dumper.
 
+	// Finds the type's info by its name, or nullptr if there's no such type.
+	const typeInfo* findType(atom name);
+	// Defines a new struct type, which replaces any older struct with the same name.
+	void registerStruct(structure& s);
+	// Registers every struct inside of 'HPL::structures' again, after they were all replaced.
+	void registerStructs();
+	// Changes every time that a struct is (re)defined, which invalidates the member caches.
+	extern unsigned structEpoch;
+
 	// Sets the color for the text that'll get printed.
 	std::string colorText(std::string txt, RETURN_OUTPUT type, bool light = false);
 
-	// Opens a file and interpretes each line.
+	// Opens a file, parses it and interpretes each statement.
 	void interpreteFile(std::string file);
-	// Interpretes a single line.
-	int interpreteLine(std::string line);
+	// Interpretes every statement inside of a block until it ends or returns.
+	void interpreteBlock(const std::vector<node>& body);
+	// Interpretes a single statement.
+	int interpreteNode(const node& statement);
 
 	// Enables debug mode (At the end it'll print everything that the interpreter remembers).
 	void debugMode();
 	// Prints out information about a vector of variables.
 	void debugPrintVar(std::vector<variable> vars, std::string indent = "\t", std::string end = "\n");
 	//Prints out information about a vector of structures.
-	void debugPrintStruct(std::vector<structure> structList, std::string indent = "\t");
+	void debugPrintStruct(const std::deque<structure>& structList, std::string indent = "\t");
 	// Prints out information about a vector of variables.
 	void debugPrintFunc(std::vector<function> func, std::string indent = "\t");
 	// Resets the interpreter's runtime information.
 	void resetRuntimeInfo();
 
-	// Checks for any includes.
-	int checkIncludes();
-	// Checks for any modes.
-	int checkModes();
-	// Checks for any conditions.
-	int checkConditions();
-	// Checks if it's a structure (if so, configure the runtime information).
-	int checkStruct();
-	// Checks for any functions.
-	int checkFunctions();
-	// Checks for any variables.
-	int checkVariables();
+	// Includes a file.
+	int interpreteInclude(const node& statement);
+	// Defines a structure.
+	int interpreteStruct(const node& statement);
+	// Defines a function.
+	int interpreteFunction(const node& statement);
+	// Checks the condition and interpretes the body if it's true.
+	int interpreteCondition(const node& statement);
+	// Interpretes the body for every element of the list.
+	int interpreteLoop(const node& statement);
+	// Sets the function's output.
+	int interpreteReturn(const node& statement);
+	// Declares (a) new variable(s).
+	int interpreteDeclaration(const node& statement, std::vector<variable>& output);
+	int interpreteDeclaration(const node& statement, variableTable& output);
+	// Edits a pre-existing variable.
+	int interpreteAssignment(const node& statement);
+	// Performs a math operation on a variable.
+	int interpreteMath(const node& statement);
+	// Executes a function.
+	int interpreteCall(const node& statement);
+	// Declares a scope and interpretes its HSM code.
+	int interpreteScope(const node& statement);
+
+	// Compares both values with the relational operator. Numbers are compared as numbers, everything else as strings.
+	bool compareValues(const std::string& value, const std::string& _operator, const std::string& value2);
+	// Performs the math operation on the variable. 'value' is null if the operator doesn't take any (eg. '++').
+	void doMath(variable& var, const std::string& _operator, const variable* value);
 
 	// Throws an intepreter error if something is wrong. This is very similar to 'printf', however as of now only '%s' and '%i' are supported.
 	void throwError(bool sendRuntimeError, std::string text, ...);
-	// Gets the current mode's name.
-	std::string getModeName();
 }
\ No newline at end of file
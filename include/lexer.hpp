@@ -0,0 +1,57 @@
+/*
+* Copyright (C) 2022-2023 EimaMei/Sacode
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+*    claim that you wrote the original software. If you use this software
+*    in a product, an acknowledgment in the product documentation would be
+*    appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+*    misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*
+*
+*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace HPL {
+	enum TOKEN_TYPE { TOKEN_EOF, TOKEN_NEWLINE, TOKEN_IDENTIFIER, TOKEN_NUMBER, TOKEN_STRING, TOKEN_FSTRING, TOKEN_OPERATOR, TOKEN_DIRECTIVE };
+
+	struct token {
+		TOKEN_TYPE type;
+		std::string_view text; // Points into the lexer's source.
+		int line;
+
+		size_t begin; // Offset of the first character inside the source.
+		size_t end;   // Offset right after the last character.
+
+		bool is(std::string_view str) const { return (type == TOKEN_OPERATOR || type == TOKEN_IDENTIFIER) && text == str; }
+	};
+
+	struct lexer {
+		std::string_view source;
+		size_t pos = 0;
+		int line = 1;
+
+		lexer(std::string_view src) : source(src) {}
+
+		// Reads the next token from the source.
+		token next();
+		// Reads raw lines until the '{' that was just read gets closed. Used
+		// for HSM code, which isn't HPL and thus can't be tokenized. The
+		// closing line itself isn't returned.
+		std::vector<std::string_view> readRawBlock(int& firstLine);
+	};
+}
@@ -0,0 +1,166 @@
+/*
+* Copyright (C) 2022-2023 EimaMei/Sacode
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+*    claim that you wrote the original software. If you use this software
+*    in a product, an acknowledgment in the product documentation would be
+*    appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+*    misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*
+*
+*/
+
+#pragma once
+
+#include <interpreter.hpp>
+#include <lexer.hpp>
+
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace HPL {
+	enum NODE_TYPE {
+		NODE_INCLUDE,     // #include <file> or #include "file"
+		NODE_READ_ONCE,   // #read once
+		NODE_STRUCT,      // struct <name> { <members> }
+		NODE_FUNCTION,    // <type> <name>(<params>) { <body> }
+		NODE_IF,          // if <condition> { <body> }
+		NODE_FOR,         // for <names> in <list or map> { <body> }, where the names are '<element>' or '<index/key>, <element>'.
+		NODE_RETURN,      // return [value]
+		NODE_DECLARATION, // <type> <names> [= <values>]
+		NODE_ASSIGNMENT,  // <name> = <value>, an element of a list (eg. 'a[i] = <value>') is the second value.
+		NODE_MATH,        // <name> <operator> [value], same as above.
+		NODE_CALL,        // <name>(<params>)
+		NODE_SCOPE        // scope <name> = { <HSM code> }
+	};
+
+	enum EXPRESSION_TYPE {
+		EXPRESSION_EMPTY,    // Nothing was given.
+		EXPRESSION_VARIABLE, // <name> or <name>.<member>
+		EXPRESSION_STRING,   // "text"
+		EXPRESSION_FSTRING,  // f"text {value}"
+		EXPRESSION_NUMBER,   // 27, 2.7
+		EXPRESSION_BOOL,     // true, false
+		EXPRESSION_STRUCT,   // {<members>}
+		EXPRESSION_CALL,     // <name>(<args>)
+		EXPRESSION_NAMED,    // <param> = <value>, an out of order argument.
+		EXPRESSION_INDEX,    // <list>[<index>] or <list>[<index>].<member>
+		EXPRESSION_PAIR,     // <key>: <value>, an entry of a map.
+		EXPRESSION_OTHER     // Anything else, gets evaluated from the source.
+	};
+
+	// Remembers how a struct member's path (eg. 'a.b.c') was resolved at an access site. As long as
+	// the variable has the same type, the next access follows the member indexes instead of the names.
+	struct memberCache {
+		atom base;                             // The variable's name before the first dot.
+		std::vector<atom> path;                // The names of the members after it.
+		int type = -1;                         // ID of the variable's type that the indexes are for, or -1.
+		unsigned epoch = 0;                    // Structs can be redefined, so the indexes are only valid for the same 'HPL::structEpoch'.
+		std::vector<std::pair<structure*, int>> members; // The struct and the member's index inside of it, for each member.
+	};
+
+	struct expression {
+		EXPRESSION_TYPE type = EXPRESSION_EMPTY;
+		std::string text;             // The expression as it's written in the source.
+		std::string name;             // Name of the function or the out of order argument's param.
+		std::vector<expression> args; // Args of the call, members of the struct, values inside of the f-string, the named argument's value, the index (and the member's path after it) or the pair's key and value.
+		int constant = -1;            // Index of the literal inside of 'HPL::constants', or -1 if it isn't one.
+		mutable std::shared_ptr<memberCache> members; // Only used by variables with a path, once they're accessed.
+	};
+
+	// A literal (or an operator) that was classified and converted once while parsing,
+	// instead of every time that it's evaluated.
+	struct constant {
+		variable value; // The literal in its own type.
+		variable other; // Numbers converted into the other number type (eg. '5' as a float).
+	};
+	// Every literal that was parsed, where the same text shares an entry.
+	extern std::vector<constant> constants;
+
+	struct node {
+		NODE_TYPE type;
+		int line;
+		std::string_view text; // The entire statement as it's written in the source.
+
+		std::string name;                // Name of the variable/function/struct, or the include's path.
+		atom valueType;                  // Type of the declaration or the return type of the function.
+		std::string _operator;           // Math operator.
+		std::vector<atom> names;         // Names of the declared variables.
+		std::vector<expression> values;  // Values, the called function or the condition's operands and operators.
+
+		std::vector<variable> params; // Params of a function.
+		int minParamCount = 0;
+
+		std::vector<node> body;               // Statements inside of a struct, function or if statement.
+		std::string_view bodySource;          // Source of a function's body until it gets parsed on the first call.
+		std::vector<std::string_view> lines;  // Raw lines of HSM code, which point into the source.
+		bool coreInclude = false;        // If the include is '<file>' instead of '"file"'.
+	};
+
+	// A read-only view of a file. It's mapped into memory, so reading the file doesn't copy it.
+	struct mappedFile {
+		const char* data = nullptr;
+		size_t size = 0;
+
+		mappedFile() = default;
+		mappedFile(const mappedFile&) = delete;
+		mappedFile& operator=(const mappedFile&) = delete;
+		~mappedFile() { close(); }
+
+		// Maps the file. Returns false if the file can't be opened.
+		bool open(const std::string& path);
+		// Unmaps the file.
+		void close();
+	};
+
+	struct program {
+		std::string file;
+		mappedFile mapping;
+		std::string_view source; // The file's content, which points into the mapping (or the executable for core libraries).
+		int lineCount = 0;
+		std::vector<node> body;
+	};
+
+	// Programs that have been parsed. Functions point to the nodes inside them,
+	// so they stay alive for the entire runtime.
+	extern std::list<program> programs;
+
+	// A file that was loaded. Every file is only mapped and parsed once, no matter how many times or how it's included.
+	struct module {
+		program* prog = nullptr;
+		bool read = false; // If the file was interpreted until the end at least once.
+	};
+	extern std::unordered_map<std::string, module> modules; // Found by the file's canonical path.
+
+	// Loads the file's statements from the built in core libraries, its cache or by
+	// parsing it. Returns nullptr if the file doesn't exist.
+	program* loadProgram(const std::string& file);
+
+	// Tokenizes and parses the program's source into a tree. 'firstLine' is the line
+	// that the source starts at, if it's only a part of a file.
+	void parseProgram(program& prog, int firstLine = 1);
+	// Parses the function's body if it wasn't yet. 'file' is where the function was defined.
+	void parseFunctionBody(const node& definition, const std::string& file);
+	// Figures out what the value is and parses everything inside of it.
+	expression parseExpression(std::string_view text);
+	// Puts the literal inside of the constant pool and sets its index. Anything else is left as is.
+	void addConstant(expression& expr);
+	// Parses a function's arguments, including out of order ones.
+	std::vector<expression> parseArguments(std::string_view params);
+	// Creates a '<name>(<params>)' call.
+	expression parseCall(std::string_view name, std::string_view params);
+}
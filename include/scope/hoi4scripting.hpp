@@ -30,7 +30,7 @@ namespace HSM { // HOI4 Scripting+ Mode
 	extern int equalBrackets;
 
 	// Interpretes a single line.
-	std::string interpreteLine(std::string line);
+	std::string interpreteLine(std::string_view line);
 
 	// Checks for any conditions.
 	int checkConditions(std::string& buffer);
@@ -0,0 +1,170 @@
+/*
+* Copyright (C) 2022-2023 EimaMei/Sacode
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+*    claim that you wrote the original software. If you use this software
+*    in a product, an acknowledgment in the product documentation would be
+*    appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+*    misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*
+*
+*/
+
+#pragma once
+
+#include <atom.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace HPL {
+	struct variable;
+	struct structure;
+	struct list;
+	struct map;
+
+	// Every possible value in HPL, packed into 16 bytes. Strings that fit are kept inside
+	// of the value itself, while longer strings, struct members, lists and maps get allocated. The
+	// indexes are the same as the ones of the old 'std::variant' (nothing, string, int, float, bool, struct).
+	//
+	// Allocated strings, members, lists and maps are shared between the copies and are only copied
+	// once a copy gets edited, so passing them around only bumps a counter.
+	class value {
+	public:
+		enum kind : uint8_t { NOTHING, STRING, INT, FLOAT, BOOL, VARS, LIST, MAP };
+
+		value() { tag = NOTHING; }
+		value(std::string_view str) { setStr(str); }
+		value(const std::string& str) { setStr(str); }
+		value(const char* str) { setStr(str); }
+		value(int num) { set(num, INT); }
+		value(float num) { set(num, FLOAT); }
+		value(bool boolean) { set(boolean, BOOL); }
+		value(const std::vector<variable>& vars);
+		value(std::vector<variable>&& vars);
+		value(const list& items);
+		value(list&& items);
+		value(const map& entries);
+		value(map&& entries);
+
+		value(const value& other) { copy(other); }
+		value(value&& other) noexcept { take(other); }
+		~value() { release(); }
+
+		value& operator=(const value& other);
+		value& operator=(value&& other) noexcept;
+
+		size_t index() const { return (tag == SHORT_STRING ? STRING : tag); }
+
+		std::string_view str() const;
+		// Makes the string editable, which always allocates it and copies it if it's shared.
+		std::string& string();
+		// Appends to the string in place, where nothing counts as an empty string. The allocated string
+		// grows its capacity geometrically, so building up a string only copies it once in a while.
+		void append(std::string_view text);
+
+		int integer() const { return get<int>(); }
+		float decimal() const { return get<float>(); }
+		bool boolean() const { return get<bool>(); }
+
+		const std::vector<variable>& vars() const { return static_cast<shared<std::vector<variable>>*>(block())->data; }
+		// Makes the members editable, which copies them if they're shared.
+		std::vector<variable>& vars();
+
+		const list& items() const;
+		// Makes the list editable, which copies it if it's shared.
+		list& items();
+
+		const map& entries() const;
+		// Makes the map editable, which copies it if it's shared.
+		map& entries();
+
+	private:
+		enum : uint8_t { SHORT_STRING = 8 };
+		static constexpr size_t shortLength = 14; // The 15th byte is the length and the 16th one is the tag.
+
+		struct counted { uint32_t refs = 1; };
+		template <class T>
+		struct shared : counted { T data; shared(T input) : data(std::move(input)) {} };
+
+		alignas(8) char data[15] = {}; // Zeroed so that copying a value never reads bytes its payload didn't set.
+		uint8_t tag;
+
+		template <class T>
+		T get() const { T output; std::memcpy(&output, data, sizeof(T)); return output; }
+		template <class T>
+		void set(T input, uint8_t kind) { std::memcpy(data, &input, sizeof(T)); tag = kind; }
+
+		bool allocated() const { return tag == STRING || tag == VARS || tag == LIST || tag == MAP; }
+		counted* block() const { return get<counted*>(); }
+
+		// Moves the other value's bytes over, without touching the counter.
+		void take(value& other) { std::memcpy(data, other.data, sizeof(data)); tag = other.tag; other.tag = NOTHING; }
+		void copy(const value& other) {
+			std::memcpy(data, other.data, sizeof(data));
+			tag = other.tag;
+
+			if (allocated())
+				block()->refs++;
+		}
+		void release() { if (allocated() && --block()->refs == 0) releaseAllocated(); }
+		void releaseAllocated();
+		void setStr(std::string_view str);
+	};
+
+	static_assert(sizeof(value) == 16);
+
+	// The elements of a list (eg. 'int[]'). Lists of a struct keep every member inside of a
+	// column of its own (struct-of-arrays), so going over one member of every element only
+	// touches that member. Elements are put back together once they're read as a whole.
+	struct list {
+		atom type;                               // Type of the elements.
+		const structure* shape = nullptr;        // The struct whose members (and their defaults) are the columns, null for core types.
+		std::vector<std::vector<value>> columns; // A single column for core types, otherwise one for each member.
+		size_t length = 0;
+
+		list() = default;
+		list(atom elementType);
+
+		size_t size() const { return length; }
+		// Finds the member's column, or -1 if the elements don't have such member.
+		int column(atom member) const;
+
+		// Puts the element together from the columns.
+		variable at(size_t index) const;
+		// Splits the element into the columns. Members that the element doesn't have get their defaults.
+		void set(size_t index, const variable& element);
+		void push_back(const variable& element);
+	};
+
+	// The elements of a map (eg. 'int[string]'), in the order that they were added. The elements
+	// are stored just like the ones of a list, the keys only find their position.
+	struct map {
+		list keys;
+		list values;
+		std::unordered_map<std::string, size_t> positions; // Position of the element, found by its key as a string.
+
+		map() = default;
+		map(atom keyType, atom elementType) : keys(keyType), values(elementType) {}
+
+		size_t size() const { return values.size(); }
+		// Finds the key's position, or -1 if the map doesn't have it.
+		int find(const value& key) const;
+		// Adds the key with the element's defaults, unless the map already has it. Returns the key's position.
+		size_t insert(const variable& key);
+	};
+}
@@ -0,0 +1,94 @@
+/*
+* Copyright (C) 2022-2023 EimaMei/Sacode
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+*    claim that you wrote the original software. If you use this software
+*    in a product, an acknowledgment in the product documentation would be
+*    appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+*    misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*
+*
+*/
+
+#pragma once
+
+#include <interpreter.hpp>
+#include <parser.hpp>
+
+#include <string>
+#include <vector>
+
+namespace HPL {
+	enum OPCODE {
+		OP_LINE,          // Sets the current line and checks for a breakpoint.
+		OP_NODE,          // Interpretes the statement with the tree-walker (includes, structs, functions, scopes, loops and elements of lists).
+		OP_READ_ONCE,     // Stops the program if the file was already read.
+
+		OP_CONSTANT,      // Pushes a literal from the constant pool, which was converted while parsing.
+		OP_EXPRESSION,    // Pushes an expression that gets evaluated once it's stored (struct literals and anything unusual).
+		OP_LOAD_LOCAL,    // Pushes a local variable from its slot.
+		OP_LOAD_MEMBER,   // Pushes a member of a local struct variable.
+		OP_LOAD_NAME,     // Pushes a variable that's found by its name.
+		OP_FSTRING,       // Pops the f-string's values and pushes the filled in string.
+		OP_CALL,          // Pops the arguments, calls the function and pushes its output. Functions run on the VM's own call stack.
+		OP_POP,           // Pops the unused value.
+
+		OP_DECLARE,       // Pops the value and declares a new variable with it.
+		OP_ASSIGN,        // Pops the value and stores it inside of an existing variable.
+		OP_GUARD,         // Evaluates the call with the tree-walker and jumps over it if the variable's type can't take a call's output directly.
+		OP_MATH,          // Pops the value (if there's one) and does the math operation on the variable.
+		OP_RETURN,        // Pops the value, sets the function's output and stops the function.
+
+		OP_TRUTHY,        // Pops a value and checks if it's true.
+		OP_COMPARE,       // Pops two values and compares them.
+		OP_OR,            // Starts a new group of checks, as '&&' takes precedence over '||'.
+		OP_JUMP_IF_FALSE, // Jumps if the condition failed.
+
+		OP_BLOCK_BEGIN,   // Remembers the variables that existed before the block.
+		OP_BLOCK_END      // Removes the block's variables, while keeping the changes to the old ones.
+	};
+
+	struct instruction {
+		OPCODE op;
+		int a = 0; // Index of the site/constant/slot or the jump's destination.
+		int b = 0; // Extra info (eg. the argument count or the declared name's index).
+	};
+
+	// Everything that an instruction might need from the source.
+	struct site {
+		const node* statement = nullptr;
+		const expression* value = nullptr;
+
+		int slot = -1;                   // Slot of the variable, or -1 if it gets found by its name.
+		std::string name;                // Name of the variable or the called function.
+		mutable memberCache members;     // Members that are accessed (eg. 'a.b.c' is {"b", "c"}) and their cached indexes.
+		atom function;                   // Name of the called function.
+		std::vector<atom> named;         // Names of the out of order arguments, empty for regular ones.
+	};
+
+	struct chunk {
+		std::vector<instruction> code;
+		std::vector<site> sites;
+		std::vector<size_t> statements; // Where each of the program's statements begins, so it can be resumed after its prelude.
+		bool isFunction = false; // Functions give their variables slots and stop on 'return'.
+	};
+
+	// Compiles the file's statements. Variables are found by their names. Just like
+	// functions, every file is only compiled once.
+	const chunk& compileProgram(const program& prog);
+	// Compiles the function's body. The compiled body is cached, so it's only done once.
+	const chunk& compileFunction(const node& definition);
+	// Runs the bytecode from 'start'. 'base' is where the function's params begin inside of 'HPL::variables'.
+	// Calls made by the bytecode don't recurse, they push the caller's frame onto the VM's own stack instead.
+	void runChunk(const chunk& code, size_t base = 0, bool alreadyRead = false, size_t start = 0);
+}
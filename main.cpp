@@ -21,13 +21,19 @@
 */
 #include <interpreter.hpp>
 #include <helper.hpp>
+#include <core.hpp>
 #include <cli.hpp>
+#include <arena.hpp>
 
 #include <iostream>
+#include <charconv>
 
 
 int main(int argc, char** argv) {
+	markStackStart();
+
 	std::string filename;
+	bool readDepth = false; // The next argument is the number after '-maxDepth'.
 
 	for (int i = 1; i < argc; i++) {
 		std::string arg = (std::string)argv[i];
@@ -39,12 +45,31 @@ int main(int argc, char** argv) {
 		checkArgs({"log", "l"}, arg, HPL::arg.debugLog, output);
 		checkArgs({"breakpoint", "b"}, arg, HPL::arg.breakpoint, output);
 		checkArgs({"dumpJson", "d"}, arg, HPL::arg.dumpJson, output);
+		checkArgs({"vm"}, arg, HPL::arg.vm, output);
+		checkArgs({"cache"}, arg, HPL::arg.cache, output);
+		checkArgs({"diskCore"}, arg, HPL::arg.diskCore, output);
+		checkArgs({"snapshot"}, arg, HPL::arg.snapshot, output);
+		checkArgs({"serve"}, arg, HPL::arg.serve, output);
+		checkArgs({"memStats"}, arg, HPL::arg.memStats, output);
+		checkArgs({"maxDepth"}, arg, readDepth, output);
 
 		if (HPL::arg.breakpoint && find(arg, ":") && HPL::arg.breakpointValues.first.empty()) {
 			std::vector<std::string> input = split(arg, ":"); // [0] - file, [1] - line.
 
 			HPL::arg.breakpointValues = std::make_pair(input[0], std::stoi(input[1]));
 		}
+		else if (readDepth && !output) {
+			int depth = 0;
+			auto [end, error] = std::from_chars(arg.data(), arg.data() + arg.size(), depth);
+
+			if (error != std::errc() || end != arg.data() + arg.size() || depth < 1) {
+				std::cout << HPL::colorText("Error",  HPL::OUTPUT_RED) << ": '-maxDepth' has to be followed by a whole number above 0, not '" << arg << "'" << std::endl;
+				return -1;
+			}
+
+			HPL::arg.maxDepth = depth;
+			readDepth = false;
+		}
 		else if (!output)
 			filename = arg;
 	}
@@ -53,6 +78,14 @@ int main(int argc, char** argv) {
 		printHelp();
 		return 0;
 	}
+	else if (HPL::arg.serve) {
+		serveDocument();
+		return 0;
+	}
+	else if (readDepth) {
+		std::cout << HPL::colorText("Error",  HPL::OUTPUT_RED) << ": '-maxDepth' has to be followed by the number of calls" << std::endl;
+		return -1;
+	}
 	else if (filename.empty()) {
 		std::cout << HPL::colorText("Error",  HPL::OUTPUT_RED) << ": No input files were provided" << std::endl;
 		return -1;
@@ -61,6 +94,9 @@ int main(int argc, char** argv) {
 
 	HPL::interpreteFile(filename);
 
+	if (HPL::arg.memStats)
+		std::cout << "Heap allocations: " << HPL::heapAllocations() << " (" << HPL::scratch.allocations() << " were made in the scratch arena instead)" << std::endl;
+
 	if (HPL::arg.dumpJson) {
 		dumpJson();
 		return 0;
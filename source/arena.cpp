@@ -0,0 +1,85 @@
+/*
+* Copyright (C) 2022-2023 EimaMei/Sacode
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+*    claim that you wrote the original software. If you use this software
+*    in a product, an acknowledgment in the product documentation would be
+*    appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+*    misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*
+*
+*/
+
+#include <arena.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+
+static size_t heapCount = 0;
+
+
+void* HPL::arena::do_allocate(size_t bytes, size_t alignment) {
+	count++;
+
+	for (;;) {
+		if (current == blocks.size()) {
+			size_t size = (bytes + alignment > blockSize ? bytes + alignment : blockSize);
+			blocks.push_back({std::make_unique_for_overwrite<char[]>(size), size});
+		}
+
+		block& b = blocks[current];
+		uintptr_t begin = (uintptr_t)b.data.get();
+		uintptr_t start = (begin + used + alignment - 1) / alignment * alignment;
+
+		if (start + bytes <= begin + b.size) {
+			used = start + bytes - begin;
+			return (void*)start;
+		}
+
+		// Doesn't fit, so the next block (or a new one) is used instead.
+		current++;
+		used = 0;
+	}
+}
+
+
+size_t HPL::heapAllocations() {
+	return heapCount;
+}
+
+
+// Every allocation goes through here, so that '-memStats' can count them.
+void* operator new(size_t size) {
+	heapCount++;
+
+	if (void* memory = std::malloc(size ? size : 1))
+		return memory;
+
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+	return operator new(size);
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t) noexcept { std::free(memory); }
+
+
+namespace HPL {
+	arena scratch;
+}
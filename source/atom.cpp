@@ -0,0 +1,77 @@
+/*
+* Copyright (C) 2022-2023 EimaMei/Sacode
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+*    claim that you wrote the original software. If you use this software
+*    in a product, an acknowledgment in the product documentation would be
+*    appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+*    misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*
+*
+*/
+
+#include <atom.hpp>
+
+#include <deque>
+#include <unordered_map>
+
+
+// Every interned name. The names are kept inside of a deque, so the views that
+// the lookup uses stay valid as new names get added.
+struct atomTable {
+	std::deque<std::string> names = {"", "int", "float", "string", "bool", "auto", "struct", "scope", "void", "relational-operator", "logical-operator", "IS_OOO"}; // Same order as 'atom::builtin'.
+	std::unordered_map<std::string_view, uint32_t> ids;
+
+	atomTable() {
+		for (uint32_t i = 0; i < names.size(); i++)
+			ids.emplace(names[i], i);
+	}
+};
+
+
+// The table gets created on its first use, as atoms are also made by static variables.
+static atomTable& getTable() {
+	static atomTable table;
+	return table;
+}
+
+
+HPL::atom::atom(std::string_view text) {
+	atomTable& table = getTable();
+	auto it = table.ids.find(text);
+
+	if (it != table.ids.end())
+		id = it->second;
+	else {
+		id = table.names.size();
+		table.names.emplace_back(text);
+		table.ids.emplace(table.names.back(), id);
+	}
+}
+
+
+bool HPL::atom::find(std::string_view text, atom& output) {
+	atomTable& table = getTable();
+	auto it = table.ids.find(text);
+
+	if (it == table.ids.end())
+		return false;
+
+	output.id = it->second;
+	return true;
+}
+
+
+const std::string& HPL::atom::str() const {
+	return getTable().names[id];
+}
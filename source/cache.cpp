@@ -0,0 +1,669 @@
+/*
+* Copyright (C) 2022-2023 EimaMei/Sacode
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+*    claim that you wrote the original software. If you use this software
+*    in a product, an acknowledgment in the product documentation would be
+*    appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+*    misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*
+*
+*/
+
+#include <cache.hpp>
+#include <helper.hpp>
+#include <cli.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+
+
+// A cache is only used when its header matches: the format below, the interpreter's version, and the hash
+// and size of its own file's source. Each file has its own cache, so editing an include only rebuilds that
+// include's cache. The checksum at the end rejects damaged caches, and anything that fails falls back to parsing.
+// Bump this whenever the layout of the statements changes, so that old caches get ignored.
+#define CACHE_FORMAT 5
+#define CACHE_MAGIC "HPLC"
+// A snapshot is only restored when its header matches: the format below, the interpreter's version, the main
+// file's path and the includes at its top. Every file that was loaded while making it also has to hash the same,
+// so editing any of them (even one that's included by another include) makes a new snapshot.
+// Same for the interpreter's state inside of snapshots.
+#define SNAPSHOT_FORMAT 2
+#define SNAPSHOT_MAGIC "HPLS"
+
+
+struct cacheWriter {
+	std::string buffer;
+	const std::deque<HPL::structure>* structures = nullptr; // Lists of structs point at them by their position.
+
+	template <class T>
+	void put(T value) { buffer.append((const char*)&value, sizeof(T)); }
+
+	void putStr(std::string_view str) {
+		put<uint32_t>(str.size());
+		buffer.append(str);
+	}
+
+	// Views point into the source, so only their location is saved.
+	void putView(std::string_view view, std::string_view source) {
+		put<uint32_t>(view.data() - source.data());
+		put<uint32_t>(view.size());
+	}
+
+	void putVar(const HPL::variable& var) {
+		putStr(var.type.str());
+		putStr(var.name.str());
+		put<uint8_t>(var.value.index());
+
+		switch (var.value.index()) {
+			case 1: putStr(var.value.str()); break;
+			case 2: put<int32_t>(getInt(var.value)); break;
+			case 3: put<float>(getFloat(var.value)); break;
+			case 4: put<uint8_t>(getBool(var.value)); break;
+			case 5:
+				put<uint32_t>(getVars(var.value).size());
+				for (const auto& member : getVars(var.value))
+					putVar(member);
+				break;
+			case 6: putList(getList(var.value)); break;
+			case 7:
+				putList(getMap(var.value).keys);
+				putList(getMap(var.value).values);
+				break;
+		}
+	}
+
+	void putList(const HPL::list& items) {
+		putStr(items.type.str());
+
+		// 0 is for core types, otherwise it's the struct's position + 1. Structs that aren't there can't be read back.
+		uint32_t shape = (items.shape == nullptr ? 0 : UINT32_MAX);
+		for (size_t i = 0; items.shape != nullptr && structures != nullptr && i < structures->size(); i++) {
+			if (&(*structures)[i] == items.shape)
+				shape = i + 1;
+		}
+		put<uint32_t>(shape);
+
+		put<uint32_t>(items.size());
+		for (const auto& column : items.columns) {
+			for (const auto& value : column)
+				putVar({.value = value});
+		}
+	}
+
+	void putExpr(const HPL::expression& expr) {
+		put<uint8_t>(expr.type);
+		putStr(expr.text);
+		putStr(expr.name);
+
+		put<uint32_t>(expr.args.size());
+		for (const auto& arg : expr.args)
+			putExpr(arg);
+	}
+
+	void putNode(const HPL::node& statement, std::string_view source) {
+		put<uint8_t>(statement.type);
+		put<int32_t>(statement.line);
+		putView(statement.text, source);
+
+		putStr(statement.name);
+		putStr(statement.valueType.str());
+		putStr(statement._operator);
+
+		put<uint32_t>(statement.names.size());
+		for (const auto& name : statement.names)
+			putStr(name.str());
+
+		put<uint32_t>(statement.values.size());
+		for (const auto& value : statement.values)
+			putExpr(value);
+
+		put<uint32_t>(statement.params.size());
+		for (const auto& param : statement.params)
+			putVar(param);
+		put<int32_t>(statement.minParamCount);
+
+		put<uint32_t>(statement.body.size());
+		for (const auto& member : statement.body)
+			putNode(member, source);
+
+		put<uint32_t>(statement.lines.size());
+		for (const auto& line : statement.lines)
+			putView(line, source);
+
+		put<uint8_t>(!statement.bodySource.empty());
+		if (!statement.bodySource.empty())
+			putView(statement.bodySource, source);
+
+		put<uint8_t>(statement.coreInclude);
+	}
+};
+
+
+// Reads the cache back. Any read past the end marks the cache as broken instead of crashing.
+struct cacheReader {
+	std::string_view data;
+	size_t pos = 0;
+	bool failed = false;
+	const std::deque<HPL::structure>* structures = nullptr; // Structs that the lists point at, by their position.
+
+	template <class T>
+	T read() {
+		T value{};
+
+		if (failed || sizeof(T) > data.size() - pos) {
+			failed = true;
+			return value;
+		}
+
+		memcpy(&value, data.data() + pos, sizeof(T));
+		pos += sizeof(T);
+
+		return value;
+	}
+
+	// Sizes of lists, which can't be larger than the rest of the cache.
+	uint32_t readCount() {
+		uint32_t count = read<uint32_t>();
+
+		if (failed || count > data.size() - pos) {
+			failed = true;
+			return 0;
+		}
+
+		return count;
+	}
+
+	std::string readStr() {
+		uint32_t size = readCount();
+		std::string str(data.substr(pos, size));
+		pos += size;
+
+		return str;
+	}
+
+	HPL::atom readAtom() {
+		uint32_t size = readCount();
+		HPL::atom name(data.substr(pos, size));
+		pos += size;
+
+		return name;
+	}
+
+	std::string_view readView(std::string_view source) {
+		uint32_t offset = read<uint32_t>(), size = read<uint32_t>();
+
+		if (offset > source.size() || size > source.size() - offset) {
+			failed = true;
+			return {};
+		}
+
+		return source.substr(offset, size);
+	}
+
+	void readVar(HPL::variable& var) {
+		var.type = readAtom();
+		var.name = readAtom();
+
+		switch (read<uint8_t>()) {
+			case 1: var.value = readStr(); break;
+			case 2: var.value = (int)read<int32_t>(); break;
+			case 3: var.value = read<float>(); break;
+			case 4: var.value = (bool)read<uint8_t>(); break;
+			case 5: {
+				std::vector<HPL::variable> members(readCount());
+				for (auto& member : members)
+					readVar(member);
+
+				var.value = members;
+				break;
+			}
+			case 6: {
+				HPL::list items;
+				readList(items);
+
+				var.value = std::move(items);
+				break;
+			}
+			case 7: {
+				HPL::map entries;
+				readList(entries.keys);
+				readList(entries.values);
+
+				for (size_t i = 0; i < entries.keys.size() && !failed; i++)
+					entries.positions[xToStr(entries.keys.columns[0][i])] = i;
+
+				var.value = std::move(entries);
+				break;
+			}
+		}
+	}
+
+	void readList(HPL::list& items) {
+		items.type = readAtom();
+
+		uint32_t shape = read<uint32_t>();
+
+		if (shape != 0 && (structures == nullptr || shape > structures->size()))
+			failed = true;
+		else if (shape != 0)
+			items.shape = &(*structures)[shape - 1];
+
+		items.length = readCount();
+		items.columns.resize(items.shape == nullptr ? 1 : items.shape->value.size());
+
+		for (auto& column : items.columns) {
+			column.resize(items.length);
+
+			for (auto& value : column) {
+				HPL::variable element;
+				readVar(element);
+				value = std::move(element.value);
+			}
+		}
+	}
+
+	void readExpr(HPL::expression& expr) {
+		expr.type = (HPL::EXPRESSION_TYPE)read<uint8_t>();
+		expr.text = readStr();
+		expr.name = readStr();
+
+		expr.args.resize(readCount());
+		for (auto& arg : expr.args)
+			readExpr(arg);
+
+		HPL::addConstant(expr); // The pool isn't cached, as its indexes depend on what else was loaded.
+	}
+
+	void readNode(HPL::node& statement, std::string_view source) {
+		statement.type = (HPL::NODE_TYPE)read<uint8_t>();
+		statement.line = read<int32_t>();
+
+		statement.text = readView(source);
+
+		statement.name = readStr();
+		statement.valueType = readAtom();
+		statement._operator = readStr();
+
+		statement.names.resize(readCount());
+		for (auto& name : statement.names)
+			name = readAtom();
+
+		statement.values.resize(readCount());
+		for (auto& value : statement.values)
+			readExpr(value);
+
+		statement.params.resize(readCount());
+		for (auto& param : statement.params)
+			readVar(param);
+		statement.minParamCount = read<int32_t>();
+
+		statement.body.resize(readCount());
+		for (auto& member : statement.body)
+			readNode(member, source);
+
+		statement.lines.resize(readCount());
+		for (auto& line : statement.lines)
+			line = readView(source);
+
+		if (read<uint8_t>())
+			statement.bodySource = readView(source);
+
+		statement.coreInclude = read<uint8_t>();
+	}
+};
+
+
+// Writes the header that has to match for the cache to be used.
+static void putHeader(cacheWriter& writer, std::string_view source) {
+	writer.buffer.append(CACHE_MAGIC);
+	writer.put<uint32_t>(CACHE_FORMAT);
+	writer.putStr(VERSION);
+	writer.put<uint64_t>(HPL::hashSource(source));
+	writer.put<uint64_t>(source.size());
+}
+
+
+uint64_t HPL::hashSource(std::string_view source) {
+	uint64_t hash = 14695981039346656037ULL;
+
+	for (char c : source) {
+		hash ^= (unsigned char)c;
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+
+std::string HPL::getCachePath(const std::string& file) {
+	return file + "c";
+}
+
+
+bool HPL::readCache(program& prog, std::string_view data) {
+	// The header is compared as a whole, since it's made the same way as when the cache was saved.
+	cacheWriter header;
+	putHeader(header, prog.source);
+
+	if (data.substr(0, header.buffer.size()) != header.buffer || data.size() < header.buffer.size() + sizeof(uint64_t))
+		return false;
+
+	// The cache ends with the hash of everything before it, so a damaged cache doesn't get used.
+	uint64_t checksum;
+	memcpy(&checksum, data.data() + data.size() - sizeof(uint64_t), sizeof(uint64_t));
+	data.remove_suffix(sizeof(uint64_t));
+
+	if (checksum != hashSource(data))
+		return false;
+
+	cacheReader reader = {data};
+	reader.pos = header.buffer.size();
+
+	int lineCount = reader.read<int32_t>();
+	std::vector<node> body(reader.readCount());
+
+	for (auto& statement : body)
+		reader.readNode(statement, prog.source);
+
+	if (reader.failed || reader.pos != data.size())
+		return false;
+
+	prog.lineCount = lineCount;
+	prog.body = std::move(body);
+
+	return true;
+}
+
+
+std::string HPL::writeCache(const program& prog) {
+	cacheWriter writer;
+	putHeader(writer, prog.source);
+
+	writer.put<int32_t>(prog.lineCount);
+	writer.put<uint32_t>(prog.body.size());
+
+	for (const auto& statement : prog.body)
+		writer.putNode(statement, prog.source);
+
+	writer.put<uint64_t>(hashSource(writer.buffer));
+
+	return writer.buffer;
+}
+
+
+bool HPL::loadCache(program& prog) {
+	FILE* fp = fopen(getCachePath(prog.file).c_str(), "rb");
+
+	if (fp == NULL)
+		return false;
+
+	std::string data;
+	fseek(fp, 0, SEEK_END);
+	long size = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+
+	data.resize(size > 0 ? size : 0);
+	data.resize(fread(data.data(), 1, data.size(), fp));
+	fclose(fp);
+
+	return readCache(prog, data);
+}
+
+
+void HPL::saveCache(const program& prog) {
+	std::string data = writeCache(prog);
+	FILE* fp = fopen(getCachePath(prog.file).c_str(), "wb");
+
+	if (fp == NULL)
+		return;
+
+	fwrite(data.data(), 1, data.size(), fp);
+	fclose(fp);
+}
+
+
+std::string HPL::getSnapshotPath(const std::string& file) {
+	return file + "s";
+}
+
+
+// Where a node is inside of the loaded files, as the index of its module and the indices down the bodies to it.
+struct nodeLocation {
+	uint32_t module;
+	std::vector<uint32_t> path;
+};
+
+
+static void findNodes(const std::vector<HPL::node>& body, nodeLocation& location, std::unordered_map<const HPL::node*, nodeLocation>& output) {
+	for (size_t i = 0; i < body.size(); i++) {
+		location.path.push_back(i);
+		output[&body[i]] = location;
+
+		findNodes(body[i].body, location, output);
+		location.path.pop_back();
+	}
+}
+
+
+// Writes the header that has to match for the snapshot to be used. The prelude's includes are a part of it,
+// so changing them makes a new snapshot.
+static void putSnapshotHeader(cacheWriter& writer, const HPL::program& prog, size_t prelude) {
+	writer.buffer.append(SNAPSHOT_MAGIC);
+	writer.put<uint32_t>(SNAPSHOT_FORMAT);
+	writer.putStr(VERSION);
+	writer.putStr(getCanonicalPath(prog.file));
+
+	writer.put<uint32_t>(prelude);
+	for (size_t i = 0; i < prelude; i++) {
+		writer.put<uint8_t>(prog.body[i].type);
+		writer.putStr(prog.body[i].name);
+		writer.put<uint8_t>(prog.body[i].coreInclude);
+	}
+}
+
+
+bool HPL::loadSnapshot(const program& prog, size_t prelude) {
+	mappedFile mapping;
+
+	if (!mapping.open(getSnapshotPath(prog.file)))
+		return false;
+
+	std::string_view data(mapping.data, mapping.size);
+
+	cacheWriter header;
+	putSnapshotHeader(header, prog, prelude);
+
+	if (data.substr(0, header.buffer.size()) != header.buffer || data.size() < header.buffer.size() + sizeof(uint64_t))
+		return false;
+
+	uint64_t checksum;
+	memcpy(&checksum, data.data() + data.size() - sizeof(uint64_t), sizeof(uint64_t));
+	data.remove_suffix(sizeof(uint64_t));
+
+	if (checksum != hashSource(data))
+		return false;
+
+	cacheReader reader = {data};
+	reader.pos = header.buffer.size();
+
+	// Every file that was loaded has to be the same as when the snapshot was made.
+	std::vector<std::pair<module*, bool>> loaded(reader.readCount());
+
+	for (auto& [mod, read] : loaded) {
+		std::string file = reader.readStr(), path = reader.readStr();
+		read = reader.read<uint8_t>();
+		uint64_t hash = reader.read<uint64_t>();
+
+		if (reader.failed || getCanonicalPath(file) != path)
+			return false;
+
+		mod = &modules[path];
+
+		if (mod->prog == nullptr)
+			mod->prog = loadProgram(file);
+
+		if (mod->prog == nullptr) {
+			modules.erase(path);
+			return false;
+		}
+		else if (hashSource(mod->prog->source) != hash)
+			return false;
+	}
+
+	auto readVars = [&](std::vector<variable>& output) {
+		output.resize(reader.readCount());
+		for (auto& var : output)
+			reader.readVar(var);
+	};
+
+	// The structs are read first, so that the lists of structs can point at them.
+	std::deque<structure> newStructures(reader.readCount());
+	reader.structures = &newStructures;
+
+	for (auto& structure : newStructures) {
+		structure.name = reader.readAtom();
+		readVars(structure.value);
+		structure.minParamCount = reader.read<int32_t>();
+		structure.defaults = structure.value;
+	}
+
+	std::vector<variable> newVariables, newCachedVariables;
+	readVars(newVariables);
+	readVars(newCachedVariables);
+
+	std::vector<function> newFunctions(reader.readCount());
+	for (auto& func : newFunctions) {
+		func.type = reader.readAtom();
+		func.name = reader.readAtom();
+		readVars(func.params);
+
+		uint32_t index = reader.read<uint32_t>();
+		if (reader.failed || index >= loaded.size())
+			return false;
+
+		const program& source = *loaded[index].first->prog;
+		const std::vector<node>* body = &source.body;
+		uint32_t depth = reader.readCount();
+
+		for (uint32_t i = 0; i < depth; i++) {
+			uint32_t at = reader.read<uint32_t>();
+
+			if (func.definition != nullptr) { // Functions inside of other functions are only there once their parent is parsed.
+				parseFunctionBody(*func.definition, source.file);
+				body = &func.definition->body;
+			}
+
+			if (reader.failed || at >= body->size())
+				return false;
+
+			func.definition = &(*body)[at];
+		}
+
+		func.minParamCount = reader.read<int32_t>();
+		func.file = reader.readStr();
+		func.startingLine = reader.read<int32_t>();
+	}
+
+	if (reader.failed || reader.pos != data.size())
+		return false;
+
+	for (auto& [mod, read] : loaded)
+		mod->read = read;
+
+	variables.assign(std::move(newVariables));
+	cachedVariables = std::move(newCachedVariables);
+	structures = std::move(newStructures);
+	registerStructs();
+	functions = std::move(newFunctions);
+
+	return true;
+}
+
+
+void HPL::saveSnapshot(const program& prog, size_t prelude) {
+	cacheWriter writer;
+	putSnapshotHeader(writer, prog, prelude);
+
+	// The main file isn't a part of the snapshot, since only its prelude has been interpreted.
+	std::string mainPath = getCanonicalPath(prog.file);
+	std::vector<std::pair<const std::string*, const module*>> saved;
+
+	for (const auto& [path, mod] : modules) {
+		if (mod.prog != nullptr && path != mainPath)
+			saved.push_back({&path, &mod});
+	}
+
+	std::unordered_map<const node*, nodeLocation> locations;
+	writer.put<uint32_t>(saved.size());
+
+	for (uint32_t i = 0; i < saved.size(); i++) {
+		const module& mod = *saved[i].second;
+		nodeLocation location = {i};
+		findNodes(mod.prog->body, location, locations);
+
+		writer.putStr(mod.prog->file);
+		writer.putStr(*saved[i].first);
+		writer.put<uint8_t>(mod.read);
+		writer.put<uint64_t>(hashSource(mod.prog->source));
+	}
+
+	auto putVars = [&](const std::vector<variable>& vars) {
+		writer.put<uint32_t>(vars.size());
+		for (const auto& var : vars)
+			writer.putVar(var);
+	};
+
+	writer.structures = &structures;
+	writer.put<uint32_t>(structures.size());
+	for (const auto& structure : structures) {
+		writer.putStr(structure.name.str());
+		putVars(structure.value);
+		writer.put<int32_t>(structure.minParamCount);
+	}
+
+	putVars(variables.values);
+	putVars(cachedVariables);
+
+	writer.put<uint32_t>(functions.size());
+	for (const auto& func : functions) {
+		auto found = locations.find(func.definition);
+
+		if (found == locations.end())
+			return; // Defined somewhere that can't be restored, so there's no snapshot.
+
+		writer.putStr(func.type.str());
+		writer.putStr(func.name.str());
+		putVars(func.params);
+
+		writer.put<uint32_t>(found->second.module);
+		writer.put<uint32_t>(found->second.path.size());
+		for (uint32_t at : found->second.path)
+			writer.put<uint32_t>(at);
+
+		writer.put<int32_t>(func.minParamCount);
+		writer.putStr(func.file);
+		writer.put<int32_t>(func.startingLine);
+	}
+
+	writer.put<uint64_t>(hashSource(writer.buffer));
+
+	FILE* fp = fopen(getSnapshotPath(prog.file).c_str(), "wb");
+
+	if (fp == NULL)
+		return;
+
+	fwrite(writer.buffer.data(), 1, writer.buffer.size(), fp);
+	fclose(fp);
+}
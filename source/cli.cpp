@@ -22,6 +22,9 @@
 #include <cli.hpp>
 #include <helper.hpp>
 #include <interpreter.hpp>
+#include <document.hpp>
+
+#include <limits>
 
 void checkArg(std::string arg, std::string input, bool& config, bool& res) {
 	if (input == ("-" + arg)) {
@@ -56,23 +59,79 @@ void printHelp() {
 					<< HPL::colorText("-log", HPL::OUTPUT_GREEN) << ", " << HPL::colorText("-l", HPL::OUTPUT_GREEN) << "                     					Logs and prints every noteworthy event that the interpreter has got." << "\n\t"
 			  		<< HPL::colorText("-strict", HPL::OUTPUT_GREEN) << ", " << HPL::colorText("-s", HPL::OUTPUT_GREEN) << "                  					Enables a strict mode, where you have a limited amount of available features to make less confusing code/massive mistakes (Barely implemented)." << "\n\t"
 					<< HPL::colorText("-breakpoint", HPL::OUTPUT_GREEN) << ", " << HPL::colorText("-b <FILE>:<LINE>", HPL::OUTPUT_GREEN) << "					Sets a breakpoint at a specific file and line where if the interpreter reaches it, it stops interpreting everything." << "\n\t"
-					<< HPL::colorText("-dumpJson", HPL::OUTPUT_GREEN) << ", " << HPL::colorText("-d", HPL::OUTPUT_GREEN) << "	                 				Dumps the entire project's information (mod name, version, variables, functions etc.) into a JSON format. Used for creating other tools with HPL.";
+					<< HPL::colorText("-dumpJson", HPL::OUTPUT_GREEN) << ", " << HPL::colorText("-d", HPL::OUTPUT_GREEN) << "	                 				Dumps the entire project's information (mod name, version, variables, functions etc.) into a JSON format. Used for creating other tools with HPL." << "\n\t"
+					<< HPL::colorText("-vm", HPL::OUTPUT_GREEN) << "	                 					Compiles the program into bytecode and runs it on a VM instead of interpreting the statements directly." << "\n\t"
+					<< HPL::colorText("-nocache", HPL::OUTPUT_GREEN) << "	                 					Always parses the files instead of loading them from their '.hplc' caches, and doesn't save any new caches." << "\n\t"
+					<< HPL::colorText("-diskCore", HPL::OUTPUT_GREEN) << "	                 					Reads the core libraries from the 'core' folder instead of using the ones that are built into the executable." << "\n\t"
+					<< HPL::colorText("-snapshot", HPL::OUTPUT_GREEN) << "	                 					Saves what the includes at the top of the file did into a '.hpls' snapshot, and restores it on the next runs instead of interpreting them again." << "\n\t"
+					<< HPL::colorText("-memStats", HPL::OUTPUT_GREEN) << "	                 					Prints how many heap allocations were made, and how many were made in the per-statement scratch arena instead." << "\n\t"
+					<< HPL::colorText("-maxDepth <N>", HPL::OUTPUT_GREEN) << "	                 					Sets how many calls can run inside of each other (1000 by default) before the program stops with an error. Calls also stop once the native stack is nearly full, which happens much sooner without '-vm'." << "\n\t"
+					<< HPL::colorText("-serve", HPL::OUTPUT_GREEN) << "	                 					Keeps a document open for editor tooling. Reads 'open <file>', 'set <size>' and 'edit <begin> <end> <size>' (followed by the text) from stdin, reparses only what changed and prints the document's symbols as JSON.";
+}
+
+
+// Converts the value to JSON, where structs and lists become arrays and maps become objects.
+static std::string jsonValue(const HPL::variable& var, bool nested = false) {
+	std::string value = xToStr(var.value);
+
+	if (isMap(var.value)) {
+		auto& entries = getMap(var.value);
+		value = "{";
+
+		for (size_t i = 0; i < entries.size(); i++) {
+			value += "\"" + xToStr(entries.keys.at(i).value) + "\" : " + jsonValue(entries.values.at(i), true);
+
+			if (i + 1 < entries.size())
+				value += ", ";
+		}
+
+		return value + "}";
+	}
+	else if (isVars(var.value) || isList(var.value)) {
+		std::vector<HPL::variable> elements;
+
+		if (isVars(var.value))
+			elements = getVars(var.value);
+		else {
+			for (size_t i = 0; i < getList(var.value).size(); i++)
+				elements.push_back(getList(var.value).at(i));
+		}
+
+		value = "[";
+
+		for (size_t i = 0; i < elements.size(); i++) {
+			value += jsonValue(elements[i], true);
+
+			if (i + 1 < elements.size())
+				value += ", ";
+		}
+
+		return value + "]";
+	}
+
+	if (var.type == HPL::atom::STRING && (nested || !value.empty()))
+		value = "\"" + value + "\"";
+	else if (value.empty())
+		value = "null";
+	else if (value.front() == '{' && value.back() == '}')
+		value = replaceAll(replaceAll(value, "{", "["), "}", "]");
+
+	return value;
 }
 
 
-void dumpJsonVariables(std::string& buffer, std::vector<HPL::variable>& vars, std::string tabs) {
+void dumpJsonVariables(std::string& buffer, std::vector<HPL::variable>& vars, std::string tabs, bool withDefaults = false) {
 	std::string lesserTab = tabs;
 	lesserTab.pop_back();
-	int i = 0;
+	size_t i = 0;
 
 	for (auto const& var : vars) {
-		std::string value = xToStr(var.value);
-		if (var.type == "string" && !value.empty())
-			value = "\"" + value + "\"";
-		else if (value.empty())
-			value = "null";
-		else if (value.front() == '{' && value.back() == '}')
-			value = replaceAll(replaceAll(value, "{", "["), "}", "]");
+		std::string value = jsonValue(var);
+		HPL::structure* s = (withDefaults && value == "[]" ? getStructFromName(var.type) : nullptr);
+
+		// Untouched struct variables still share their struct's defaults.
+		if (s != nullptr)
+			value = jsonValue({.type = var.type, .value = s->value});
 
 		buffer += "\n" + lesserTab +
 		"\"" + var.name + "\" : {\n" + tabs +
@@ -88,11 +147,12 @@ void dumpJsonVariables(std::string& buffer, std::vector<HPL::variable>& vars, st
 }
 
 
-void dumpJsonStructures(std::string& buffer, std::vector<HPL::structure>& structures, std::string tabs) {
+template<typename T>
+static void dumpJsonStructures(std::string& buffer, T& structures, std::string tabs) {
 	std::string lesserTab = tabs;
 	lesserTab.pop_back();
 	std::string varTab = tabs + "\t\t";
-	int i = 0;
+	size_t i = 0;
 
 	for (auto& s : structures) {
 		buffer += "\n" + lesserTab +
@@ -110,16 +170,21 @@ void dumpJsonStructures(std::string& buffer, std::vector<HPL::structure>& struct
 }
 
 
-void dumpJsonFunctions(std::string& buffer, std::vector<HPL::function>& funcs, std::string tabs) {
+void dumpJsonFunctions(std::string& buffer, std::vector<HPL::function>& funcs, std::string tabs, bool withLines = false) {
 	std::string lesserTab = tabs;
 	lesserTab.pop_back();
 	std::string varTab = tabs + "\t\t";
-	int i = 0;
+	size_t i = 0;
 
 	for (auto& func : funcs) {
 		buffer += "\n" + lesserTab +
 		"\"" + func.name + "\" : {\n" + tabs +
-			"\"type\" : \"" + func.type + "\",\n" + tabs +
+			"\"type\" : \"" + func.type + "\",\n" + tabs;
+
+		if (withLines)
+			buffer += "\"line\" : " + std::to_string(func.startingLine) + ",\n" + tabs;
+
+		buffer +=
 			"\"params\" : {";
 				dumpJsonVariables(buffer, func.params, varTab); buffer += "\n" + tabs +
 			"}\n" + lesserTab +
@@ -160,11 +225,11 @@ void dumpJson() {
 		"},\n\t"
 
 		"\"variables\" : {";
-			dumpJsonVariables(buffer, HPL::variables, "\t\t\t"); buffer += "\n\t"
+			dumpJsonVariables(buffer, HPL::variables.values, "\t\t\t", true); buffer += "\n\t"
 		"},\n\t"
 
 		"\"cachedVariables\" : {";
-			dumpJsonVariables(buffer, HPL::cachedVariables, "\t\t\t"); buffer += "\n\t"
+			dumpJsonVariables(buffer, HPL::cachedVariables, "\t\t\t", true); buffer += "\n\t"
 		"},\n\t"
 
 		"\"functions\" : {";
@@ -178,4 +243,76 @@ void dumpJson() {
 	buffer += "}";
 
 	std::printf("%s", buffer.c_str());
-}
\ No newline at end of file
+}
+
+
+// Dumps the symbols of the document that's being edited.
+static void dumpDocumentJson(HPL::document& doc) {
+	std::string buffer =
+	"{\n\t"
+		"\"file\" : \"" + doc.file + "\",\n\t"
+
+		"\"variables\" : {";
+			dumpJsonVariables(buffer, doc.variables, "\t\t\t"); buffer += "\n\t"
+		"},\n\t"
+
+		"\"functions\" : {";
+			dumpJsonFunctions(buffer, doc.functions, "\t\t\t", true); buffer += "\n\t"
+		"},\n\t"
+
+		"\"structures\" : {";
+			dumpJsonStructures(buffer, doc.structures, "\t\t\t"); buffer += "\n\t"
+		"},\n\t"
+
+		"\"errors\" : [";
+			for (size_t i = 0; i < doc.errors.size(); i++) {
+				std::string message = replaceAll(replaceAll(doc.errors[i].message, "\\", "\\\\"), "\"", "\\\"");
+
+				buffer += "\n\t\t{\"line\" : " + std::to_string(doc.errors[i].line) + ", \"message\" : \"" + message + "\"}";
+				if (i + 1 < doc.errors.size())
+					buffer += ",";
+			}
+			buffer += "\n\t"
+		"]\n";
+
+	buffer += "}";
+
+	std::cout << buffer << std::endl;
+}
+
+
+void serveDocument() {
+	HPL::document doc;
+	std::string command;
+
+	while (std::cin >> command) {
+		if (command == "open") { // open <file>
+			std::getline(std::cin >> std::ws, doc.file);
+			HPL::mappedFile mapping;
+
+			doc.open(mapping.open(doc.file) ? std::string_view(mapping.data, mapping.size) : std::string_view());
+		}
+		else if (command == "set" || command == "edit") { // set <size> or edit <begin> <end> <size>, followed by a new line and the text.
+			size_t begin = 0, end = std::string::npos, size = 0;
+
+			if (command == "edit")
+				std::cin >> begin >> end;
+			std::cin >> size;
+			std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+			std::string text(size, '\0');
+			std::cin.read(text.data(), size);
+
+			if (command == "set")
+				doc.open(text);
+			else
+				doc.edit(begin, end, text);
+		}
+		else if (command == "quit")
+			break;
+		else
+			continue;
+
+		dumpDocumentJson(doc);
+	}
+}
@@ -20,214 +20,190 @@
 *
 */
 #include <interpreter.hpp>
+#include <parser.hpp>
 #include <core.hpp>
 #include <helper.hpp>
 #include <functions.hpp>
+#include <vm.hpp>
 
+#include <cstdint>
 #include <iostream>
 
+#if !defined(WINDOWS)
+#include <sys/resource.h>
+#endif
 
-std::vector<std::string> coreTypes = {
-	"string", // Works just like std::string.
-	"int",    // Regular int.
-	"float",  // Regular float.
-	"bool",   // Regular bloat.
-	"scope",  // A scope variable, meaning HOI4 code can be executed inside of it.
-	"auto"    // Generic type.
+using namespace HPL::literals;
+
+
+std::vector<HPL::atom> coreTypes = {
+	HPL::atom::STRING, // Works just like std::string.
+	HPL::atom::INT,    // Regular int.
+	HPL::atom::FLOAT,  // Regular float.
+	HPL::atom::BOOL,   // Regular bloat.
+	HPL::atom::SCOPE,  // A scope variable, meaning HOI4 code can be executed inside of it.
+	HPL::atom::AUTO    // Generic type.
 };
 
 
 bool foundFunction = false; // If we found the function.
 int startOrgAt = 0; // At which index we should start the organization. NOTE: A possible bug exists, where the first few params are in order, but then afterwards the defines out of order arguments have the same first few param names, ending in shenanigans. Needs fixing.
 HPL::function globalFunction; // The found function.
+int callDepth = 0;
+static uintptr_t stackStart = 0; // Where 'main' started on the native stack, or 0 if it wasn't marked.
+static size_t stackSize = 0;     // How much of the native stack the calls can use.
+
+
+void markStackStart() {
+	char here;
+	stackStart = (uintptr_t)&here;
+	stackSize = 1024 * 1024; // Windows' default.
+
+	#if !defined(WINDOWS)
+	rlimit limit;
+	stackSize = 8 * 1024 * 1024;
+
+	if (getrlimit(RLIMIT_STACK, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY)
+		stackSize = limit.rlim_cur;
+	#endif
+
+	// A quarter is kept for whatever the last call does before its body calls again, and for the error itself.
+	stackSize -= stackSize / 4;
+}
 
 
 int executeFunction(std::string name, std::string info, HPL::function& function, HPL::variable& output, bool dontCheck/* = false*/) {
+	return executeFunction(name, HPL::parseArguments(info), function, output, dontCheck);
+}
+
+
+int executeFunction(std::string name, const std::vector<HPL::expression>& args, HPL::function& function, HPL::variable& output, bool dontCheck/* = false*/) {
 	// General params.
-	std::vector<std::string> values = split(info, ",", "(){}\"\"");
 	std::vector<HPL::variable> params;
 	bool organizeParams = false; // If we have to organize params.
 
 	if (HPL::arg.debugLog || HPL::arg.debugAll)
 		HPL::arg.curIndent += "\t";
 
-	for (auto& p : values) {
+	for (const auto& arg : args) {
 		HPL::variable var;
 
-		// Removing the spaces and quotes from match.
-		std::string oldMatch = removeFrontAndBackSpaces(p); // In case the match is actually a string.
-		p = unstringify(oldMatch);
-
 		// Out of order initialization settings.
-		bool outOfOrder = false; // Is out of order.
-		std::string outOfOrderParam; // The name of the param.
-
-
-		// Found an out of order argument.
-		if (find(oldMatch, "=") && !isStr(oldMatch)) {
-			// Find the param and true value.
-			useRegex(oldMatch, R"(\s*(\w*)\s*\=\s*(f?\".*\"|\{.*\}|\w*\(.*\)|[\d\s\+\-\*\/\.]+[^\w]*|[^\s]*)\s*.*)");
+		bool outOfOrder = (arg.type == HPL::EXPRESSION_NAMED); // Is out of order.
+		const HPL::expression& value = (outOfOrder ? arg.args[0] : arg); // The true value.
 
-			if (!HPL::matches.empty()) { // If we found the param and value.
-				outOfOrder = true;
-				organizeParams = true;
-				outOfOrderParam = HPL::matches.str(1);
-
-				oldMatch = HPL::matches.str(2);
-				p = unstringify(oldMatch);
-			}
-			else
-				HPL::throwError(true, "Invalid syntax");
-		}
-
-		if (!outOfOrder && organizeParams) { // If the input didn't set the param name, even though we're in out of order init mode.
-			HPL::throwError(true, "All out of order argument initializations must be accompanied with the name of the param (format is '%s', not just '%s')", "<param> = <value>", p.c_str());
+		if (outOfOrder)
+			organizeParams = true;
+		else if (organizeParams) { // If the input didn't set the param name, even though we're in out of order init mode.
+			HPL::throwError(true, "All out of order argument initializations must be accompanied with the name of the param (format is '%s', not just '%s')", "<param> = <value>", value.text.c_str());
 		}
 
-		// Checks if the parameter is just a function.
-		if (useRegex(p, R"(^\s*([^\s\(]+)\((.*)\)\s*$)")) {
-			// If so, get the name and params of said parameter.
-			std::vector<HPL::vector> funcValues, oldFuncValues;
-			std::string str = p;
-			while (true) {
-				// Check if the param isn't just a function.
-				useRegex(str, R"(\s*([^\s\(]+)\((.*)\)\s*)");
-				if (!HPL::matches.str(2).empty() || !str.empty()) {
-					funcValues.insert(funcValues.begin(), HPL::matches);
-					str = HPL::matches.str(2);
-				}
-				else
-					break;
-			}
-
-			oldFuncValues = funcValues;
-
-			for (int i = 0; i < funcValues.size(); i++) {
-				// Since the param DOES have functions inside, we have to get that functions' output.
-				auto list = split(funcValues[i].str(2), ",", "(){}\"\"");
-				assignFuncReturnToVar(&var, funcValues[i].str(1), funcValues[i].str(2), true);
-
-				if ((i + 1) < funcValues.size()) { // If there are more functions inside the param.
-					auto& noodles = funcValues[i + 1].value[1]; // Get the next function.
-
-					auto msg = xToStr(var.value); // Get the return from the current function.
-					if (!isInt(p) && p != "true" && p != "false")
-						msg = '\"' + msg + '\"'; // Since it's a string, we have to add quotes
-
-					// Since the next function's param is gonna be "{currentFunctionName}({currentFunctionParams})",
-					// we have to replace that with the current function's output (aka msg).
-					noodles = replaceOnce(noodles, oldFuncValues[i].str(1) + "(" + oldFuncValues[i].str(2) + ")", msg);
-				}
-			}
-		}
+		// Since the param is a function, we have to get that functions' output.
+		if (value.type == HPL::EXPRESSION_CALL)
+			assignFuncReturnToVar(&var, value);
 		else {
-			bool res = setCorrectValue(var, oldMatch, false);
+			bool res = evaluateExpression(var, value, false);
 
 			if (!res)
-				HPL::throwError(true, "Variable '%s' doesn't exist (Cannot use a variable that doesn't exist).", p.c_str());
+				HPL::throwError(true, "Variable '%s' doesn't exist (Cannot use a variable that doesn't exist).", value.text.c_str());
 		}
 
 		if (organizeParams) // Set the 'var.name' to the param's name, since 'var.name' isn't needed for functions.
-			var.name = outOfOrderParam;
+			var.name = HPL::atom(arg.name);
 		else
 			startOrgAt++;
 
-		params.push_back(var);
+		params.push_back(std::move(var));
 
 		if (HPL::arg.debugAll || HPL::arg.debugLog)
-			std::cout << HPL::arg.curIndent << "LOG: [FIND][PARAM]: " << HPL::curFile << ":" << HPL::lineCount << ": <type> <name> = <value>: " << printVar(var) << std::endl;
+			std::cout << HPL::arg.curIndent << "LOG: [FIND][PARAM]: " << HPL::curFile << ":" << HPL::lineCount << ": <type> <name> = <value>: " << printVar(params.back()) << std::endl;
 	}
+
+	return callFunction(HPL::atom(name), params, organizeParams, function, output, dontCheck);
+}
+
+
+int callFunction(HPL::atom name, std::vector<HPL::variable>& params, bool organizeParams, HPL::function& function, HPL::variable& output, bool dontCheck/* = false*/) {
+	pendingCall call;
+	int res = beginCall(name, params, organizeParams, call, output, dontCheck, &function);
+
+	if (call.function == -1) // A core function (or nothing) was called.
+		return res;
+
+	const HPL::node& definition = *HPL::functions[call.function].definition;
+
+	if (HPL::arg.vm)
+		HPL::runChunk(HPL::compileFunction(definition), call.base);
+	else
+		HPL::interpreteBlock(definition.body);
+
+	if (!HPL::arg.interprete)
+		return FOUND_NOTHING;
+
+	function = HPL::functions[call.function];
+	endCall(call, output);
+
+	return FOUND_SOMETHING;
+}
+
+
+int beginCall(HPL::atom name, std::vector<HPL::variable>& params, bool organizeParams, pendingCall& call, HPL::variable& output, bool dontCheck/* = false*/, HPL::function* coreFunction/* = nullptr*/) {
 	foundFunction = false;
 	globalFunction.name = name;
 
 	if (organizeParams)
-		params.push_back(HPL::variable{.type = "IS_OOO"});
+		params.push_back(HPL::variable{.type = HPL::atom::OUT_OF_ORDER});
 
 	output.value = coreFunctions(params);
 
 	if (foundFunction) {
-		function = globalFunction;
-		output.type = function.type;
-		globalFunction = {};
+		output.type = globalFunction.type;
 
 		if (HPL::arg.debugAll || HPL::arg.debugLog) {
-			std::cout << HPL::arg.curIndent << "LOG: [FIND][FUNCTION](0): " << HPL::curFile << ":" << HPL::lineCount << ": <type> <name> | <output> (<output's type>): " << function.type << " " << function.name << " | " << xToStr(output.value) << " (" << output.type << ")" << std::endl;
+			std::cout << HPL::arg.curIndent << "LOG: [FIND][FUNCTION](0): " << HPL::curFile << ":" << HPL::lineCount << ": <type> <name> | <output> (<output's type>): " << globalFunction.type << " " << globalFunction.name << " | " << xToStr(output.value) << " (" << output.type << ")" << std::endl;
 			HPL::arg.curIndent.pop_back();
 		}
 
+		if (coreFunction != nullptr)
+			*coreFunction = globalFunction;
+
+		globalFunction = {};
 		return FOUND_SOMETHING;
 	}
 
 	// Non-core functions
-	for (const auto& func : HPL::functions) {
+	for (size_t index = 0; index < HPL::functions.size(); index++) {
+		const HPL::function& func = HPL::functions[index];
+
 		if (useFunction(func, params)) {
+			char here;
+
+			if (++callDepth > HPL::arg.maxDepth)
+				HPL::throwError(true, "Too many nested calls (Function '%s' was called inside of %i other calls, use '-maxDepth <N>' to raise the limit).", func.name.c_str(), callDepth - 1);
+			if (stackStart != 0 && stackStart - (uintptr_t)&here > stackSize)
+				HPL::throwError(true, "Too many nested calls (Function '%s' was called inside of %i other calls, which is as many as the native stack can fit).", func.name.c_str(), callDepth - 1);
+
 			// Save the info and reset it all so that the interpreter doesn't spout random info.
-			std::string oldCurFile = HPL::curFile;
-			auto oldLineCount = HPL::lineCount;
-			auto oldVars = HPL::variables;
-			auto oldMode = HPL::mode;
-			auto oldEqualBrackets = HPL::equalBrackets;
+			call = {(int)index, HPL::curFile, HPL::lineCount, HPL::variables.size()};
+			globalFunction = {};
 
 			HPL::resetRuntimeInfo();
 			HPL::curFile = func.file;
 			HPL::lineCount = func.startingLine;
 
-			for (int i = 0; i < func.params.size(); i++) {
+			for (size_t i = 0; i < func.params.size(); i++) {
 				auto var = func.params[i];
 
 				if (i < params.size())
-					var.value = params[i].value;
-
-				HPL::variables.push_back(var);
+					var.value = std::move(params[i].value);
 
 				if (HPL::arg.dumpJson)
 					HPL::cachedVariables.push_back(var);
-			}
-
-			for (const auto& line : func.code) {
-				HPL::lineCount++;
-				HPL::interpreteLine(line);
 
-				if (HPL::functionOutput.has_value()) // If the function returned something, exit.
-					break;
-				if (!HPL::arg.interprete)
-					return FOUND_NOTHING;
+				HPL::variables.push_back(std::move(var));
 			}
 
-			// Set the output value and type.
-			output = HPL::functionOutput;
-			// Reset the saved output value and type.
-			HPL::functionOutput.reset_all();
-
-
-			// If a global variable was edited in the function, save the changes.
-			for (auto& oldV : oldVars) {
-				for (auto& newV : HPL::variables) {
-					if (oldV.name == newV.name) {
-						oldV.value = newV.value;
-						break;
-					}
-				}
-			}
-
-			// Reset everything back to normal.
-			HPL::variables = oldVars;
-			HPL::curFile = oldCurFile;
-			HPL::lineCount = oldLineCount;
-			HPL::mode = oldMode;
-			HPL::equalBrackets = oldEqualBrackets;
-
-			globalFunction = func;
-			foundFunction = true;
-
-			if (HPL::arg.debugAll || HPL::arg.debugLog) {
-				std::cout << HPL::arg.curIndent << "LOG: [FIND][FUNCTION](1): " << HPL::curFile << ":" << HPL::lineCount << ": <type> <name> | <output> (<output's type>): " << func.type << " " << func.name << " | " << xToStr(output.value) << " (" << output.type << ")" << std::endl;
-				HPL::arg.curIndent.pop_back();
-			}
-
-			function = globalFunction;
-			globalFunction = {};
-
+			HPL::parseFunctionBody(*func.definition, func.file);
 			return FOUND_SOMETHING;
 		}
 	}
@@ -239,16 +215,39 @@ int executeFunction(std::string name, std::string info, HPL::function& function,
 }
 
 
-bool useFunction(HPL::function func, std::vector<HPL::variable>& sentUserParams) {
+void endCall(pendingCall& call, HPL::variable& output) {
+	const HPL::function& func = HPL::functions[call.function];
+	callDepth--;
+
+	// Set the output value and type.
+	output = std::move(HPL::functionOutput);
+	// Reset the saved output value and type.
+	HPL::functionOutput.reset_all();
+
+	// The function's variables are always on top, while the old ones were edited in place.
+	HPL::variables.resize(call.base);
+
+	HPL::curFile = std::move(call.oldCurFile);
+	HPL::lineCount = call.oldLineCount;
+
+	if (HPL::arg.debugAll || HPL::arg.debugLog) {
+		std::cout << HPL::arg.curIndent << "LOG: [FIND][FUNCTION](1): " << HPL::curFile << ":" << HPL::lineCount << ": <type> <name> | <output> (<output's type>): " << func.type << " " << func.name << " | " << xToStr(output.value) << " (" << output.type << ")" << std::endl;
+		if (!HPL::arg.curIndent.empty())
+			HPL::arg.curIndent.pop_back();
+	}
+}
+
+
+bool useFunction(const HPL::function& func, std::vector<HPL::variable>& sentUserParams) {
 	bool organize = false;
 	int size = sentUserParams.size();
 
-	if (!sentUserParams.empty() && sentUserParams.back().type == "IS_OOO") {
+	if (!sentUserParams.empty() && sentUserParams.back().type == HPL::atom::OUT_OF_ORDER) {
 		size--;
 		organize = true;
 	}
 
-	if (func.name == globalFunction.name && func.params.size() < size)
+	if (func.name == globalFunction.name && (int)func.params.size() < size)
 		HPL::throwError(true, "Too many parameters were provided (you provided '%i' arguments when function '%s' requires at least '%i' arguments)", size, func.name.c_str(), func.params.size());
 	if (func.name == globalFunction.name && func.minParamCount > size)
 		HPL::throwError(true, "Too few parameters were provided (you provided '%i' arguments when function '%s' requires at least '%i' arguments)", size, func.name.c_str(), func.minParamCount);
@@ -256,7 +255,7 @@ bool useFunction(HPL::function func, std::vector<HPL::variable>& sentUserParams)
 
 	if (func.name == globalFunction.name) {
 		if (organize) { // If there are any out of order arguments.
-			HPL::function* outOfOrderFunc = &func; // The function.
+			const HPL::function* outOfOrderFunc = &func; // The function.
 			sentUserParams.pop_back();
 
 			std::vector<HPL::variable> organizedParams = outOfOrderFunc->params;
@@ -268,7 +267,7 @@ bool useFunction(HPL::function func, std::vector<HPL::variable>& sentUserParams)
 				int paramIndex = 0;
 				num++;
 
-				if (!find(buf, outOfOrderParam.name)) // Checks for any duplicates.
+				if (!find(buf, outOfOrderParam.name.str())) // Checks for any duplicates.
 					buf += outOfOrderParam.name;
 				else
 					HPL::throwError(true, "Cannot initialize the same param multiple times (param '%s' was initialized multiple times).", outOfOrderParam.name.c_str());
@@ -299,9 +298,13 @@ bool useFunction(HPL::function func, std::vector<HPL::variable>& sentUserParams)
 
 		startOrgAt = 0; // Reset out of order initialization organization.
 
-		for (int i = 0; i < func.params.size(); i++) {
+		for (size_t i = 0; i < func.params.size(); i++) {
 			if ((i + 1) <= sentUserParams.size()) {
-				if (!coreTyped(func.params[i].type)) {
+				bool container = (getListElement(func.params[i].type) != nullptr || getMapKey(func.params[i].type) != nullptr);
+
+				if (getListElement(func.params[i].type) != nullptr && sentUserParams[i].type == HPL::atom::STRUCT) // A struct literal can be passed as a list, where every member is an element.
+					structToList(sentUserParams[i], func.params[i].type);
+				else if (!coreTyped(func.params[i].type) && !container) {
 					auto& userParams = getVars(sentUserParams[i].value);
 
 					HPL::structure* _struct = getStructFromName(func.params[i].type);
@@ -309,25 +312,28 @@ bool useFunction(HPL::function func, std::vector<HPL::variable>& sentUserParams)
 					if (_struct->value.size() < userParams.size())
 						HPL::throwError(true, "Too many members were provided (you provided '%i' arguments when struct '%s' takes at most '%i' members)", userParams.size(), _struct->name.c_str(), userParams.size());
 
-					for (int x = 0; x < userParams.size(); x++) {
+					for (size_t x = 0; x < userParams.size(); x++) {
 						auto& member = _struct->value[x];
 
-						if (member.type != userParams[x].type && member.type != "auto")
+						if (member.type != userParams[x].type && member.type != HPL::atom::AUTO)
 							HPL::throwError(true, "Members' types do not match ('%s' is %s-typed, while '%s' is %s-typed)", member.name.c_str(), member.type.c_str(), userParams[x].name.c_str(), userParams[x].type.c_str());
 					}
 					sentUserParams[i].type = func.params[i].type; // why?
 				}
 
-				if (func.params[i].type != sentUserParams[i].type && func.params[i].type != "auto")
+				if (func.params[i].type != sentUserParams[i].type && func.params[i].type != HPL::atom::AUTO)
 					HPL::throwError(true, "Cannot input a '%s' type to a %s-only parameter (param '%s' is %s-only)", sentUserParams[i].type.c_str(), func.params[i].type.c_str(), func.params[i].name.c_str(), func.params[i].type.c_str());
 			}
 
 			if (func.params[i].has_value() && (i + 1) > sentUserParams.size()) {// If the function has default parameters that weren't covered
 				auto var = func.params[i];
+				bool empty = (isVars(var.value) ? getVars(var.value).empty() : var.value.index() == HPL::value::STRING && var.value.str() == "{}");
 
-				std::string value = xToStr(var.value);
-				if (value == "{}")
-					setCorrectValue(var, xToStr(var.value), true);
+				// Struct params share the struct's defaults until one of their members gets written.
+				if (empty && getStructFromName(var.type) != nullptr)
+					var.value = std::vector<HPL::variable>();
+				else if (empty)
+					setCorrectValue(var, "{}", true);
 
 				sentUserParams.push_back(var);
 			}
@@ -342,51 +348,72 @@ bool useFunction(HPL::function func, std::vector<HPL::variable>& sentUserParams)
 }
 
 
-int assignFuncReturnToVar(HPL::variable* existingVar, std::string funcName, std::string funcParam, bool dontCheck/* = false*/) {
+int assignFuncReturnToVar(HPL::variable* existingVar, const HPL::expression& call, bool dontCheck/* = false*/) {
+	const std::string& funcName = call.name;
 	HPL::function func;
 	HPL::variable output;
-	executeFunction(funcName, funcParam, func, output, dontCheck);
+	executeFunction(funcName, call.args, func, output, dontCheck);
+
+	return assignOutputToVar(existingVar, funcName, func.type, output);
+}
+
 
+int assignOutputToVar(HPL::variable* existingVar, const std::string& funcName, HPL::atom funcType, HPL::variable& output) {
 	if (output.has_value()) {
-		if (output.type == "struct") {
-			HPL::structure* s = getStructFromName(func.type);
+		if (getListElement(funcType) != nullptr || getMapKey(funcType) != nullptr) {
+			if (output.type == HPL::atom::STRUCT && getListElement(funcType) != nullptr)
+				structToList(output, funcType);
+			else if (output.type != funcType)
+				HPL::throwError(true, "Cannot return a '%s' type (the return type for '%s' is '%s', not '%s')", output.type.c_str(), funcName.c_str(), funcType.c_str(), output.type.c_str());
+
+			if (existingVar->type.empty())
+				existingVar->type = funcType;
+			else if (existingVar->type != funcType)
+				HPL::throwError(true, "Cannot store a '%s' type inside of a %s-typed variable (the return type for '%s' is '%s')", funcType.c_str(), existingVar->type.c_str(), funcName.c_str(), funcType.c_str());
+
+			existingVar->value = output.value;
+
+			return FOUND_SOMETHING;
+		}
+
+		if (output.type == HPL::atom::STRUCT) {
+			HPL::structure* s = getStructFromName(funcType);
 			if (s != nullptr) {
-				if (existingVar->type != func.type) {
+				if (existingVar->type != funcType) {
 					HPL::throwError(true, "later");
 				}
 				else {
-					auto result = getVars(output.value);
-					existingVar->value = result;
+					existingVar->value = output.value;
 				}
 
 				return FOUND_SOMETHING;
 			}
 		}
 
-		if (func.type != output.type)
-			HPL::throwError(true, "Cannot return a '%s' type (the return type for '%s' is '%s', not '%s')", output.type.c_str(), funcName.c_str(), func.type.c_str(), output.type.c_str());
+		if (funcType != output.type)
+			HPL::throwError(true, "Cannot return a '%s' type (the return type for '%s' is '%s', not '%s')", output.type.c_str(), funcName.c_str(), funcType.c_str(), output.type.c_str());
 
 		std::string value = xToStr(output.value);
 
-		if (existingVar->type == "string")
+		if (existingVar->type == HPL::atom::STRING)
 			existingVar->value = value;
-		else if (existingVar->type == "int")
+		else if (existingVar->type == HPL::atom::INT)
 			existingVar->value = (int)stringToFloat(value);
-		else if (existingVar->type == "bool")
+		else if (existingVar->type == HPL::atom::BOOL)
 			existingVar->value = stringToBool(value);
-		else if (existingVar->type == "float")
+		else if (existingVar->type == HPL::atom::FLOAT)
 			existingVar->value = stringToFloat(value);
 		else {
-			if (func.type == "string")
+			if (funcType == HPL::atom::STRING)
 				existingVar->value = getStr(output.value);
-			else if (func.type == "int")
+			else if (funcType == HPL::atom::INT)
 				existingVar->value = getInt(output.value);
-			else if (func.type == "bool")
+			else if (funcType == HPL::atom::BOOL)
 				existingVar->value = getBool(output.value);
-			else if (func.type == "float")
+			else if (funcType == HPL::atom::FLOAT)
 				existingVar->value = getFloat(output.value);
 
-			existingVar->type = func.type;
+			existingVar->type = funcType;
 		}
 	}
 	else {
@@ -399,72 +426,71 @@ int assignFuncReturnToVar(HPL::variable* existingVar, std::string funcName, std:
 }
 
 
-allowedTypes coreFunctions(std::vector<HPL::variable> params) {
-	if (useFunction({.type = "void", .name = "print", .params = {{"auto", "msg"}, {"string", "ending", "\n"}}, .minParamCount = 1}, params))
-		print(params[0], getStr(params[1].value));
-
-	else if (useFunction({.type = "string", .name = "str", .params = {{"auto", "value"}}, .minParamCount = 1}, params))
-		return func_str(params[0]);
-
-	else if (useFunction({.type = "int", .name = "int", .params = {{"auto", "value"}}, .minParamCount = 1}, params))
-		return func_int(params[0]);
-
-	else if (useFunction({.type = "bool", .name = "bool", .params = {{"auto", "value"}}, .minParamCount = 1}, params))
-		return func_bool(params[0]);
-
-	else if (useFunction({.type = "float", .name = "float", .params = {{"auto", "value"}}, .minParamCount = 1}, params))
-		return func_float(params[0]);
-
-	else if (useFunction({.type = "int", .name = "createFolder", .params = {{"string", "path"}}, .minParamCount = 1}, params))
-		return createFolder(getStr(params[0].value));
-
-	else if (useFunction({.type = "int", .name = "removeFolder", .params = {{"string", "path"}}, .minParamCount = 1}, params))
-		return removeFolder(getStr(params[0].value));
-
-	else if (useFunction({.type = "int", .name = "createFile", .params = {{"string", "path"}, {"string", "content", ""}, {"bool", "useUtf8BOM", false}}, .minParamCount = 1}, params))
-		return createFile(getStr(params[0].value), getStr(params[1].value), getBool(params[2].value));
-
-	else if (useFunction({.type = "int", .name = "readFile", .params = {{"string", "path"}}, .minParamCount = 1}, params))
-		return readFile(getStr(params[0].value));
-
-	else if (useFunction({.type = "int", .name = "writeFile",  .params = {{"string", "path"}, {"string", "content"}, {"string", "mode", "w"}}, .minParamCount = 2}, params))
-		return writeFile(getStr(params[0].value), getStr(params[1].value), getStr(params[2].value));
-
-	else if (useFunction({.type = "int", .name = "removeFile", .params = {{"string", "path"}}, .minParamCount = 1}, params))
-		return removeFile(getStr(params[0].value));
-
-	else if (useFunction({.type = "int", .name = "copyFile", .params = {{"string", "source"}, {"string", "output"}}, .minParamCount = 2}, params))
-		return copyFile(getStr(params[0].value), getStr(params[1].value));
-
-	else if (useFunction({.type = "int", .name = "writeToLine", .params = {{"string", "path"}, {"int", "line"}, {"string", "content"}, {"string", "mode", "w"}}, .minParamCount = 3}, params))
-		return writeToLine(getStr(params[0].value), getInt(params[1].value), getStr(params[2].value), getStr(params[3].value));
-
-	else if (useFunction({.type = "int", .name = "writeToMultipleLines", .params = {{"string", "path"}, {"int", "lineBegin"}, {"int", "lineEnd"}, {"string", "content"}, {"string", "mode", "w"}}, .minParamCount = 4}, params))
-		return writeToMultipleLines(getStr(params[0].value), getInt(params[1].value), getInt(params[2].value), getStr(params[3].value), getStr(params[4].value));
-
-	else if (useFunction({.type = "int", .name = "writeLocalisation", .params = {{"string", "file"}, {"string", "name"}, {"string", "description"}}, .minParamCount = 3}, params))
-		return writeLocalisation(getStr(params[0].value), getStr(params[1].value), getStr(params[2].value));
-
-	else if (useFunction({.type = "int", .name = "convertToDds", .params = {{"string", "input"}, {"string", "output"}}, .minParamCount = 2}, params))
-		return convertToDds(getStr(params[0].value), getStr(params[1].value));
-
-	else if (useFunction({.type = "string", .name = "getFilenameFromPath", .params = {{"string", "path"}}, .minParamCount = 1}, params))
-		return getFilenameFromPath(getStr(params[0].value));
-
-	else if (useFunction({.type = "bool", .name = "pathExists", .params = {{"string", "path"}}, .minParamCount = 1}, params))
-		return pathExists(getStr(params[0].value));
-
-	else if (useFunction({.type = "bool", .name = "find", .params = {{"string", "line"}, {"string", "input"}}, .minParamCount = 2}, params))
-		return find(getStr(params[0].value), getStr(params[1].value));
+// A function that's built into the interpreter.
+struct coreFunction {
+	HPL::function definition;
+	allowedTypes (*call)(std::vector<HPL::variable>& params); // Gets called with the checked params.
+};
 
-	else if (useFunction({.type = "string", .name = "replaceAll", .params = {{"string", "str"}, {"string", "oldString"}, {"string", "newString"}}, .minParamCount = 3}, params))
-		return replaceAll(getStr(params[0].value), getStr(params[1].value), getStr(params[2].value));
+// The definitions only get created once, instead of every time that a function is called.
+static const std::vector<coreFunction> coreFunctionList = {
+	{{.type = "void"_atom, .name = "print"_atom, .params = {{"auto"_atom, "msg"_atom}, {"string"_atom, "ending"_atom, "\n"}}, .minParamCount = 1},
+		[](std::vector<HPL::variable>& params) -> allowedTypes { print(params[0], getStr(params[1].value)); return {}; }},
+	{{.type = "string"_atom, .name = "str"_atom, .params = {{"auto"_atom, "value"_atom}}, .minParamCount = 1},
+		[](std::vector<HPL::variable>& params) -> allowedTypes { return func_str(params[0]); }},
+	{{.type = "int"_atom, .name = "int"_atom, .params = {{"auto"_atom, "value"_atom}}, .minParamCount = 1},
+		[](std::vector<HPL::variable>& params) -> allowedTypes { return func_int(params[0]); }},
+	{{.type = "bool"_atom, .name = "bool"_atom, .params = {{"auto"_atom, "value"_atom}}, .minParamCount = 1},
+		[](std::vector<HPL::variable>& params) -> allowedTypes { return func_bool(params[0]); }},
+	{{.type = "float"_atom, .name = "float"_atom, .params = {{"auto"_atom, "value"_atom}}, .minParamCount = 1},
+		[](std::vector<HPL::variable>& params) -> allowedTypes { return func_float(params[0]); }},
+	{{.type = "int"_atom, .name = "createFolder"_atom, .params = {{"string"_atom, "path"_atom}}, .minParamCount = 1},
+		[](std::vector<HPL::variable>& params) -> allowedTypes { return createFolder(getStr(params[0].value)); }},
+	{{.type = "int"_atom, .name = "removeFolder"_atom, .params = {{"string"_atom, "path"_atom}}, .minParamCount = 1},
+		[](std::vector<HPL::variable>& params) -> allowedTypes { return removeFolder(getStr(params[0].value)); }},
+	{{.type = "int"_atom, .name = "createFile"_atom, .params = {{"string"_atom, "path"_atom}, {"string"_atom, "content"_atom, ""}, {"bool"_atom, "useUtf8BOM"_atom, false}}, .minParamCount = 1},
+		[](std::vector<HPL::variable>& params) -> allowedTypes { return createFile(getStr(params[0].value), getStr(params[1].value), getBool(params[2].value)); }},
+	{{.type = "int"_atom, .name = "readFile"_atom, .params = {{"string"_atom, "path"_atom}}, .minParamCount = 1},
+		[](std::vector<HPL::variable>& params) -> allowedTypes { return readFile(getStr(params[0].value)); }},
+	{{.type = "int"_atom, .name = "writeFile"_atom,  .params = {{"string"_atom, "path"_atom}, {"string"_atom, "content"_atom}, {"string"_atom, "mode"_atom, "w"}}, .minParamCount = 2},
+		[](std::vector<HPL::variable>& params) -> allowedTypes { return writeFile(getStr(params[0].value), getStr(params[1].value), getStr(params[2].value)); }},
+	{{.type = "int"_atom, .name = "removeFile"_atom, .params = {{"string"_atom, "path"_atom}}, .minParamCount = 1},
+		[](std::vector<HPL::variable>& params) -> allowedTypes { return removeFile(getStr(params[0].value)); }},
+	{{.type = "int"_atom, .name = "copyFile"_atom, .params = {{"string"_atom, "source"_atom}, {"string"_atom, "output"_atom}}, .minParamCount = 2},
+		[](std::vector<HPL::variable>& params) -> allowedTypes { return copyFile(getStr(params[0].value), getStr(params[1].value)); }},
+	{{.type = "int"_atom, .name = "writeToLine"_atom, .params = {{"string"_atom, "path"_atom}, {"int"_atom, "line"_atom}, {"string"_atom, "content"_atom}, {"string"_atom, "mode"_atom, "w"}}, .minParamCount = 3},
+		[](std::vector<HPL::variable>& params) -> allowedTypes { return writeToLine(getStr(params[0].value), getInt(params[1].value), getStr(params[2].value), getStr(params[3].value)); }},
+	{{.type = "int"_atom, .name = "writeToMultipleLines"_atom, .params = {{"string"_atom, "path"_atom}, {"int"_atom, "lineBegin"_atom}, {"int"_atom, "lineEnd"_atom}, {"string"_atom, "content"_atom}, {"string"_atom, "mode"_atom, "w"}}, .minParamCount = 4},
+		[](std::vector<HPL::variable>& params) -> allowedTypes { return writeToMultipleLines(getStr(params[0].value), getInt(params[1].value), getInt(params[2].value), getStr(params[3].value), getStr(params[4].value)); }},
+	{{.type = "int"_atom, .name = "writeLocalisation"_atom, .params = {{"string"_atom, "file"_atom}, {"string"_atom, "name"_atom}, {"string"_atom, "description"_atom}}, .minParamCount = 3},
+		[](std::vector<HPL::variable>& params) -> allowedTypes { return writeLocalisation(getStr(params[0].value), getStr(params[1].value), getStr(params[2].value)); }},
+	{{.type = "int"_atom, .name = "convertToDds"_atom, .params = {{"string"_atom, "input"_atom}, {"string"_atom, "output"_atom}}, .minParamCount = 2},
+		[](std::vector<HPL::variable>& params) -> allowedTypes { return convertToDds(getStr(params[0].value), getStr(params[1].value)); }},
+	{{.type = "string"_atom, .name = "getFilenameFromPath"_atom, .params = {{"string"_atom, "path"_atom}}, .minParamCount = 1},
+		[](std::vector<HPL::variable>& params) -> allowedTypes { return getFilenameFromPath(getStr(params[0].value)); }},
+	{{.type = "bool"_atom, .name = "pathExists"_atom, .params = {{"string"_atom, "path"_atom}}, .minParamCount = 1},
+		[](std::vector<HPL::variable>& params) -> allowedTypes { return pathExists(getStr(params[0].value)); }},
+	{{.type = "bool"_atom, .name = "find"_atom, .params = {{"string"_atom, "line"_atom}, {"string"_atom, "input"_atom}}, .minParamCount = 2},
+		[](std::vector<HPL::variable>& params) -> allowedTypes { return find(params[0].value.str(), params[1].value.str()); }},
+	{{.type = "string"_atom, .name = "replaceAll"_atom, .params = {{"string"_atom, "str"_atom}, {"string"_atom, "oldString"_atom}, {"string"_atom, "newString"_atom}}, .minParamCount = 3},
+		[](std::vector<HPL::variable>& params) -> allowedTypes { return replaceAll(params[0].value.str(), params[1].value.str(), params[2].value.str()); }},
+	{{.type = "int"_atom, .name = "len"_atom, .params = {{"auto"_atom, "value"_atom}}, .minParamCount = 1},
+		[](std::vector<HPL::variable>& params) -> allowedTypes { return len(params[0]); }},
+	{{.type = "bool"_atom, .name = "hasKey"_atom, .params = {{"auto"_atom, "map"_atom}, {"auto"_atom, "key"_atom}}, .minParamCount = 2},
+		[](std::vector<HPL::variable>& params) -> allowedTypes { return hasKey(params[0], params[1]); }},
+	{{.type = "void"_atom, .name = "HPL_throwError"_atom, .params = {{"string"_atom, "messsage"_atom}}, .minParamCount = 1},
+		[](std::vector<HPL::variable>& params) -> allowedTypes { HPL::throwError(true, getStr(params[0].value)); return {}; }}
+};
 
-	else if (useFunction({.type = "int", .name = "len", .params = {{"auto", "value"}}, .minParamCount = 1}, params))
-		return len(params[0]);
 
-	else if (useFunction({.type = "void", .name = "HPL_throwError", .params = {{"string", "messsage"}}, .minParamCount = 1}, params))
-		HPL::throwError(true, getStr(params[0].value));
+allowedTypes coreFunctions(std::vector<HPL::variable>& params) {
+	for (const auto& f : coreFunctionList) {
+		if (f.definition.name == globalFunction.name) {
+			if (useFunction(f.definition, params))
+				return f.call(params);
+			break;
+		}
+	}
 
 	return {};
 }
\ No newline at end of file
@@ -0,0 +1,208 @@
+/*
+* Copyright (C) 2022-2023 EimaMei/Sacode
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+*    claim that you wrote the original software. If you use this software
+*    in a product, an acknowledgment in the product documentation would be
+*    appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+*    misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*
+*
+*/
+
+#include <document.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+
+// Removes the color codes from the error's message.
+static std::string removeColors(const std::string& str) {
+	std::string output;
+
+	for (size_t i = 0; i < str.size(); i++) {
+		if (str[i] == '\x1B') {
+			while (i < str.size() && str[i] != 'm')
+				i++;
+		}
+		else if (str[i] != '\n')
+			output += str[i];
+	}
+
+	return output;
+}
+
+
+// Parses the document's text between 'begin' and 'end' into regions. Returns false if it has a syntax error.
+static bool parseRegions(HPL::document& doc, size_t begin, size_t end, int line, std::list<HPL::region>& output) {
+	auto source = std::make_shared<const std::string>(doc.text.substr(begin, end - begin));
+	HPL::program prog;
+	prog.file = doc.file;
+	prog.source = *source;
+
+	// The parser reports errors by printing and throwing them, so the message is caught instead.
+	std::ostringstream message;
+	std::streambuf* oldBuffer = std::cout.rdbuf(message.rdbuf());
+	std::string oldFile = HPL::curFile;
+	int oldLineCount = HPL::lineCount;
+	HPL::curFile = doc.file;
+	bool parsed = true;
+
+	try {
+		HPL::parseProgram(prog, line);
+	}
+	catch (const std::runtime_error&) {
+		parsed = false;
+	}
+
+	std::cout.rdbuf(oldBuffer);
+	int errorLine = HPL::lineCount;
+	HPL::curFile = oldFile;
+	HPL::lineCount = oldLineCount;
+
+	if (!parsed) {
+		output.push_back({begin, end - begin, line, source, {}, {errorLine, removeColors(message.str())}});
+		return false;
+	}
+
+	// Where the statement begins. A directive's text doesn't have its '#'.
+	auto getStart = [&](const HPL::node& statement) {
+		size_t start = statement.text.data() - source->data();
+		return (start > 0 && (*source)[start - 1] == '#' ? start - 1 : start);
+	};
+
+	// Every statement starts a new region, anything before the first one belongs to it too.
+	for (size_t i = 0; i < prog.body.size() || i == 0; i++) {
+		size_t start = (i == 0 ? 0 : getStart(prog.body[i]));
+		size_t next = (i + 1 < prog.body.size() ? getStart(prog.body[i + 1]) : source->size());
+
+		HPL::region& reg = output.emplace_back(HPL::region{begin + start, next - start, (i == 0 ? line : prog.body[i].line), source});
+
+		if (i < prog.body.size())
+			reg.body.push_back(std::move(prog.body[i]));
+	}
+
+	return true;
+}
+
+
+// Collects the symbols from every region.
+static void updateSymbols(HPL::document& doc) {
+	doc.structures.clear();
+	doc.functions.clear();
+	doc.variables.clear();
+	doc.errors.clear();
+
+	for (const auto& reg : doc.regions) {
+		if (!reg.error.message.empty())
+			doc.errors.push_back({reg.error.line + reg.lineShift, reg.error.message});
+
+		for (const auto& statement : reg.body) {
+			switch (statement.type) {
+				case HPL::NODE_STRUCT: {
+					HPL::structure& s = doc.structures.emplace_back(HPL::structure{HPL::atom(statement.name)});
+
+					for (const auto& member : statement.body) {
+						for (const auto& name : member.names)
+							s.value.push_back({member.valueType, name});
+					}
+					break;
+				}
+				case HPL::NODE_FUNCTION:
+					doc.functions.push_back({statement.valueType, HPL::atom(statement.name), statement.params, &statement, statement.minParamCount, doc.file, statement.line + reg.lineShift});
+					break;
+				case HPL::NODE_DECLARATION:
+					for (const auto& name : statement.names)
+						doc.variables.push_back({statement.valueType, name});
+					break;
+				case HPL::NODE_SCOPE:
+					doc.variables.push_back({statement.valueType, HPL::atom(statement.name)});
+					break;
+				default:
+					break;
+			}
+		}
+	}
+}
+
+
+void HPL::document::open(std::string_view newText) {
+	text = newText;
+	regions.clear();
+
+	parseRegions(*this, 0, text.size(), 1, regions);
+	updateSymbols(*this);
+}
+
+
+void HPL::document::edit(size_t begin, size_t end, std::string_view newText) {
+	begin = std::min(begin, text.size());
+	end = std::clamp(end, begin, text.size());
+
+	long delta = (long)newText.size() - (long)(end - begin);
+	int lineDelta = std::count(newText.begin(), newText.end(), '\n') - std::count(text.begin() + begin, text.begin() + end, '\n');
+	text.replace(begin, end - begin, newText);
+
+	// The regions that the edit touches, along with the one before them. A statement can continue on the
+	// next lines (eg. a function's '{'), so the edit might change where the previous statement ends.
+	auto first = regions.begin(), last = regions.begin();
+
+	for (auto it = regions.begin(); it != regions.end(); it++) {
+		if (it->begin <= begin)
+			first = it;
+		if (it->begin <= end)
+			last = it;
+	}
+
+	if (first != regions.begin())
+		first--;
+
+	// The region after the edit gets parsed again too. If a statement still starts right where it did, then
+	// the parser is back in sync and nothing after it changed. Otherwise the edit changed where the statements
+	// end (eg. opened a block or a scope's HSM code), so the rest of the document gets parsed.
+	auto resync = std::next(last);
+	size_t resyncBegin = 0;
+
+	if (resync != regions.end()) {
+		resyncBegin = resync->begin + delta;
+		last = resync;
+	}
+
+	size_t sliceBegin = first->begin, sliceEnd = last->begin + last->size + delta;
+	std::list<region> parsed;
+	bool synced = parseRegions(*this, sliceBegin, sliceEnd, first->line, parsed);
+
+	if (synced && resync != regions.end())
+		synced = (parsed.back().begin == resyncBegin && !parsed.back().body.empty());
+
+	if (!synced && sliceEnd < text.size()) {
+		parsed.clear();
+		sliceEnd = text.size();
+		last = std::prev(regions.end());
+
+		parseRegions(*this, sliceBegin, sliceEnd, first->line, parsed);
+	}
+
+	auto after = regions.erase(first, std::next(last));
+
+	for (auto it = after; it != regions.end(); it++) {
+		it->begin += delta;
+		it->line += lineDelta;
+		it->lineShift += lineDelta;
+	}
+
+	regions.splice(after, parsed);
+	updateSymbols(*this);
+}
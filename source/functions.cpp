@@ -49,18 +49,18 @@
 #include <deps/SOIL2.h>
 
 
-void print(HPL::variable msg, std::string end/* = \n*/) {
+void print(const HPL::variable& msg, std::string end/* = \n*/) {
 	std::string output;
 
 	if (isVars(msg.value)) {
 		output += "{";
 		auto& _struct = getVars(msg.value);
 
-		for (int memberIndex = 0; memberIndex < _struct.size(); memberIndex++) {
+		for (size_t memberIndex = 0; memberIndex < _struct.size(); memberIndex++) {
 			auto& member = _struct[memberIndex];
 
 			if (member.has_value()) {
-				if (member.type == "string")
+				if (member.type == HPL::atom::STRING)
 					output += "\"" + xToStr(member.value) + "\"";
 				else
 					output += xToStr(member.value);
@@ -78,15 +78,32 @@ void print(HPL::variable msg, std::string end/* = \n*/) {
 }
 
 
-std::string func_str(HPL::variable value) { return xToStr(value.value); }
-int func_int(HPL::variable value) { return xToType<int>(value.value); }
-float func_float(HPL::variable value) { return xToType<float>(value.value); }
-bool func_bool(HPL::variable value) { return xToType<bool>(value.value); }
-int len(HPL::variable value) { return xToStr(value.value).size(); }
+std::string func_str(const HPL::variable& value) { return xToStr(value.value); }
+int func_int(const HPL::variable& value) { return xToType<int>(value.value); }
+float func_float(const HPL::variable& value) { return xToType<float>(value.value); }
+bool func_bool(const HPL::variable& value) { return xToType<bool>(value.value); }
+
+
+int len(const HPL::variable& value) {
+	if (isList(value.value))
+		return getList(value.value).size();
+	else if (isMap(value.value))
+		return getMap(value.value).size();
+
+	return xToStr(value.value).size();
+}
+
+
+bool hasKey(const HPL::variable& map, const HPL::variable& key) {
+	if (!isMap(map.value))
+		HPL::throwError(true, "Cannot look for a key in a %s type (Only maps have keys).", map.type.c_str());
+
+	return getMap(map.value).find(key.value) != -1;
+}
 
 
 int createFolder(std::string path) {
-	int check;
+	int check = 0;
 	std::string fullPath;
 	std::vector<std::string> folders = split(path, "/");
 
@@ -184,7 +201,7 @@ int writeToMultipleLines(std::string path, int lineBegin, int lineEnd, std::stri
 			size_t res = fread(tempBuf, 1, size, f);
 			tempBuf[size] = 0;
 
-			for(int i = 0; i < res; i++) {
+			for(size_t i = 0; i < res; i++) {
 				if (tempBuf[i] == '\n')
 					entireCount++;
 			}
@@ -25,18 +25,23 @@
 #include <interpreter.hpp>
 #include <core.hpp>
 #include <helper.hpp>
+#include <arena.hpp>
 
 #include <iostream>
 #include <sstream>
 #include <cstring>
+#include <cctype>
+#include <unordered_map>
+#include <filesystem>
 
 // Each commit split just keeps getting more and more complex...
-std::vector<std::string> split(std::string str, std::string value, std::string charScope/* = "\0\0"*/) {
+std::vector<std::string> split(std::string_view str, std::string_view value, std::string_view charScope/* = "\0\0"*/) {
 	std::vector<std::string> list;
-	std::string buf, buf2;
+	HPL::arena::scope temporaries(HPL::scratch); // The buffers grow one character at a time, so they're kept in the scratch arena.
+	std::pmr::string buf(&HPL::scratch), buf2(&HPL::scratch);
 	int counter = 0;
 	bool found;
-	std::string lastScope = "";
+	std::pmr::string lastScope(&HPL::scratch);
 
 	for (auto x : str) {
 		found = false;
@@ -47,8 +52,8 @@ std::vector<std::string> split(std::string str, std::string value, std::string c
 		else
 			buf2 += '\0';
 
-		for (int i = 0; i < charScope.size(); i += 2) {
-			if (charScope[i] != '\0' && x == charScope[i] && (x != charScope[i + 1] || (x == charScope[i + 1] && !find(lastScope, std::string(1, x))))) {
+		for (size_t i = 0; i < charScope.size(); i += 2) {
+			if (charScope[i] != '\0' && x == charScope[i] && (x != charScope[i + 1] || (x == charScope[i + 1] && lastScope.find(x) == std::string::npos))) {
 				if (buf[buf.size() - 2] == '\\' && x == '\"')
 					break;
 
@@ -56,33 +61,64 @@ std::vector<std::string> split(std::string str, std::string value, std::string c
 				found = true;
 				lastScope += charScope[i + 1];
 			}
-			else if (charScope[i + 1] != '\0' && x == charScope[i + 1] && !lastScope.empty() && find(lastScope, std::string(1, charScope[i + 1]))) {
+			else if (charScope[i + 1] != '\0' && x == charScope[i + 1] && !lastScope.empty() && lastScope.find(charScope[i + 1]) != std::string::npos) {
 				if (buf[buf.size() - 2] == '\\' && x == '\"')
 					break;
 
-				std::string d(1, charScope[i + 1]);
 				counter++;
 				found = true;
-				lastScope = replaceOnce(lastScope, d, "");
+				lastScope.erase(lastScope.find(charScope[i + 1]), 1);
 			}
 		}
 
 		if (buf2.find(value) != std::string::npos && counter == 0 && !found) {
-			std::string msg = buf.substr(0, buf2.find(value));
-			list.insert(list.end(), msg);
+			list.emplace_back(buf.data(), buf2.find(value));
 			buf.clear();
 			buf2.clear();
 		}
 	}
-	if (buf.size() != 0) list.insert(list.end(), buf);
+	if (buf.size() != 0) list.emplace_back(buf);
 
 	return list;
 }
 
 
-bool useRegex(std::string str, std::string regexText) {
-	std::smatch matches;
-	bool res = std::regex_search(str, matches, std::regex(regexText));
+// Lets the regex cache be searched with a 'std::string_view', without
+// creating a temporary 'std::string' on each lookup.
+struct regexHash {
+	using is_transparent = void;
+	size_t operator()(std::string_view str) const { return std::hash<std::string_view>{}(str); }
+};
+
+// Every regex that has been compiled so far. Compiling a 'std::regex' is
+// far more expensive than actually using it, so each pattern only gets
+// compiled once.
+static std::unordered_map<std::string, std::regex, regexHash, std::equal_to<>> regexCache;
+
+
+static const std::regex& getRegex(std::string_view regexText) {
+	auto it = regexCache.find(regexText);
+
+	if (it == regexCache.end())
+		it = regexCache.emplace(std::string(regexText), std::regex(regexText.begin(), regexText.end())).first;
+
+	return it->second;
+}
+
+
+// Adds the capture to 'HPL::matches', pointing into 'str'.
+static void pushMatch(std::string_view str, const std::csub_match& match) {
+	if (match.matched)
+		HPL::matches.push_back(str.substr(match.first - str.data(), match.length()));
+	else
+		HPL::matches.push_back({});
+}
+
+
+bool useRegex(std::string_view str, std::string_view regexText) {
+	HPL::arena::scope temporaries(HPL::scratch);
+	std::pmr::cmatch matches(&HPL::scratch); // The matches are only copied into 'HPL::matches' as views.
+	bool res = std::regex_search(str.data(), str.data() + str.size(), matches, getRegex(regexText));
 
 	// For some reason after 'useRegex' and 'HPL::matches' is out
 	// of the function scope, the data gets corrupted and spews
@@ -100,113 +136,277 @@ bool useRegex(std::string str, std::string regexText) {
 	// which I don't particulary mind as std::vector seems to be
 	// much more reliable than std::smatch.
 	HPL::matches.clear();
-	for (int i = 1; i < matches.size(); i++)
-		HPL::matches.push_back(matches.str(i));
+	for (size_t i = 1; i < matches.size(); i++)
+		pushMatch(str, matches[i]);
 
 	return res;
 }
 
 
-bool useIterativeRegex(std::string str, std::string regexText) {
-	std::smatch match;
+bool useIterativeRegex(std::string_view str, std::string_view regexText) {
+	const std::regex& regex = getRegex(regexText);
+	const char* start = str.data();
+	const char* end = str.data() + str.size();
+	HPL::arena::scope temporaries(HPL::scratch);
+	std::pmr::cmatch match(&HPL::scratch);
 	HPL::matches.clear();
 	bool res;
-    while ((res = std::regex_search(str, match, std::regex(regexText)))) {
-		HPL::matches.push_back(match.str(1));
-        str = match.suffix();
-    }
+	while ((res = std::regex_search(start, end, match, regex))) {
+		pushMatch(str, match[1]);
+		start = match[0].second;
+	}
 
 	return res;
 }
 
 
-std::string removeSpaces(std::string str) {
-	str.erase(remove(str.begin(), str.end(), ' '), str.end());
-	return str;
+static bool isWordChar(char c) { return std::isalnum((unsigned char)c) || c == '_'; }
+static bool isSpaceChar(char c) { return std::isspace((unsigned char)c); }
+
+
+// Finds the last 'c' between 'start' and the end of the line ('.*' can't go past a newline).
+static size_t findLastOnLine(std::string_view str, size_t start, char c) {
+	size_t lineEnd = str.find('\n', start);
+	if (lineEnd == std::string_view::npos)
+		lineEnd = str.size();
+
+	for (size_t i = lineEnd; i > start; i--) {
+		if (str[i - 1] == c)
+			return i - 1;
+	}
+
+	return std::string_view::npos;
 }
 
 
-std::string removeFrontAndBackSpaces(std::string str) {
-	int i = 0, i2 = 0;
+bool matchFunctionCall(std::string_view str, bool wholeLine/* = true*/) {
+	HPL::matches.clear();
+	size_t i = 0;
 
-	for (const auto& c : str) { // Find the front spaces.
-		if (c == ' ' || c == '\t')
+	while (i < str.size()) {
+		while (i < str.size() && isSpaceChar(str[i]))
 			i++;
-		else
+
+		size_t nameEnd = i;
+		while (nameEnd < str.size() && !isSpaceChar(str[nameEnd]) && str[nameEnd] != '(')
+			nameEnd++;
+
+		if (nameEnd != i && nameEnd < str.size() && str[nameEnd] == '(') {
+			size_t paramsEnd = findLastOnLine(str, nameEnd + 1, ')');
+
+			if (paramsEnd != std::string_view::npos) {
+				bool valid = true;
+
+				for (size_t x = paramsEnd + 1; wholeLine && x < str.size(); x++)
+					valid &= isSpaceChar(str[x]);
+
+				if (valid) {
+					HPL::matches.push_back(str.substr(i, nameEnd - i));
+					HPL::matches.push_back(str.substr(nameEnd + 1, paramsEnd - nameEnd - 1));
+					return true;
+				}
+			}
+		}
+
+		// When the call has to be the whole line, the name can only start at the beginning.
+		if (wholeLine)
 			break;
+
+		i = (nameEnd == i ? i + 1 : nameEnd);
 	}
-	str = str.substr(i, str.size()); // Delete the front spaces.
 
+	return false;
+}
 
-	for (i2 = str.size() - 1; 0 < i2; ) { // Find the back spaces.
-		if (str[i2] == ' ')
-			i2--;
-		else
-			break;
+
+// Length of the value of an out of order argument, same as the regex
+// 'f?\".*\"|\{.*\}|\w*\(.*\)|[\d\s\+\-\*\/\.]+[^\w]*|[^\s]*'.
+static size_t matchNamedParamValue(std::string_view str, size_t start) {
+	size_t end;
+
+	// f?\".*\"
+	size_t quote = start + (start < str.size() && str[start] == 'f');
+	if (quote < str.size() && str[quote] == '\"' && (end = findLastOnLine(str, quote + 1, '\"')) != std::string_view::npos)
+		return end + 1 - start;
+	if (start < str.size() && str[start] == '\"' && (end = findLastOnLine(str, start + 1, '\"')) != std::string_view::npos)
+		return end + 1 - start;
+
+	// \{.*\}
+	if (start < str.size() && str[start] == '{' && (end = findLastOnLine(str, start + 1, '}')) != std::string_view::npos)
+		return end + 1 - start;
+
+	// \w*\(.*\)
+	end = start;
+	while (end < str.size() && isWordChar(str[end]))
+		end++;
+	if (end < str.size() && str[end] == '(' && (end = findLastOnLine(str, end + 1, ')')) != std::string_view::npos)
+		return end + 1 - start;
+
+	// [\d\s\+\-\*\/\.]+[^\w]*
+	end = start;
+	while (end < str.size() && (std::isdigit((unsigned char)str[end]) || isSpaceChar(str[end]) || std::strchr("+-*/.", str[end]) != nullptr))
+		end++;
+	if (end != start) {
+		while (end < str.size() && !isWordChar(str[end]))
+			end++;
+
+		return end - start;
+	}
+
+	// [^\s]*
+	while (end < str.size() && !isSpaceChar(str[end]))
+		end++;
+
+	return end - start;
+}
+
+
+bool matchNamedParam(std::string_view str) {
+	HPL::matches.clear();
+
+	for (size_t start = 0; start < str.size(); start++) {
+		size_t i = start;
+		while (i < str.size() && isSpaceChar(str[i]))
+			i++;
+
+		size_t nameStart = i;
+		while (i < str.size() && isWordChar(str[i]))
+			i++;
+
+		size_t nameEnd = i;
+		while (i < str.size() && isSpaceChar(str[i]))
+			i++;
+
+		if (i >= str.size() || str[i] != '=')
+			continue;
+
+		i++;
+		while (i < str.size() && isSpaceChar(str[i]))
+			i++;
+
+		HPL::matches.push_back(str.substr(nameStart, nameEnd - nameStart));
+		HPL::matches.push_back(str.substr(i, matchNamedParamValue(str, i)));
+		return true;
 	}
-	str = str.substr(0, i2 + 1); // Delte the back spaces.
+
+	return false;
+}
+
+
+std::string removeSpaces(std::string_view str) {
+	std::string output;
+	output.reserve(str.size());
+
+	for (char c : str) {
+		if (c != ' ')
+			output += c;
+	}
+
+	return output;
+}
+
+
+std::string_view removeFrontAndBackSpaces(std::string_view str) {
+	size_t front = str.find_first_not_of(" \t");
+
+	if (front == std::string_view::npos)
+		return {};
+
+	str.remove_prefix(front); // Delete the front spaces.
+	str.remove_suffix(str.size() - 1 - str.find_last_not_of(' ')); // Delete the back spaces.
 
 	return str;
 }
 
 
-std::string unstringify(std::string str, bool noChecks/* = false*/, char character/* = '"'*/) {
-	if ((str.front() == 'f' && str[1] == '\"' && str.back() == '\"'))
+std::string_view unstringify(std::string_view str, bool noChecks/* = false*/, char character/* = '"'*/) {
+	if (str.size() > 1 && str.front() == 'f' && str[1] == '\"' && str.back() == '\"')
 		return str;
 
-	if (str[0] == character || noChecks)
-		str.erase(0, 1);
-	if (str[str.size() - 1] == character || noChecks)
-		str.pop_back();
+	if (!str.empty() && (str.front() == character || noChecks))
+		str.remove_prefix(1);
+	if (!str.empty() && (str.back() == character || noChecks))
+		str.remove_suffix(1);
 
 	return str;
 }
 
 
-std::string getPathFromFilename(std::string filename) {
+std::string_view getPathFromFilename(std::string_view filename) {
 	return filename.substr(0, filename.find_last_of("/\\"));
 }
 
 
-bool find(std::string line, std::string str) {
-	return (line.find(str) != std::string::npos);
+std::string getCanonicalPath(const std::string& path) {
+	std::error_code error;
+	auto canonical = std::filesystem::weakly_canonical(path, error);
+
+	if (error) // Still get rid of the '.' and '..' parts.
+		return std::filesystem::path(path).lexically_normal().generic_string();
+
+	return canonical.generic_string();
+}
+
+
+bool find(std::string_view line, std::string_view str) {
+	return (line.find(str) != std::string_view::npos);
 }
 
 
-bool isInt(std::string str) {
- 	str = replaceAll(str, ".", ""); // For any possible floats.
-    if (str.empty()) // String was just dots for whatever reason, not a decimal eitherway.
-		return false;
+bool isInt(std::string_view str) {
+	bool digits = false; // String that's just dots isn't a decimal eitherway.
+
+	for (char c : str) {
+		if (c == '.') // For any possible floats.
+			continue;
+		if (std::string_view("0123456789+-/*()").find(c) == std::string_view::npos)
+			return false;
+
+		digits = true;
+	}
 
-    return str.find_first_not_of("0123456789+-/*()") == std::string::npos;
+	return digits;
 }
 
 
-bool isStr(std::string str) {
-	return (str.front() == '\"' && str.back() == '\"') || (str.front() == 'f' && str[1] == '\"' && str.back() == '\"');
+bool isStr(std::string_view str) {
+	if (str.empty())
+		return false;
+
+	return (str.front() == '\"' && str.back() == '\"') || (str.size() > 1 && str.front() == 'f' && str[1] == '\"' && str.back() == '\"');
 }
 
 
-std::string replaceAll(std::string str, std::string oldString, std::string newString) {
-	for( size_t pos = 0; ; pos += newString.length() ) {
-        // Locate the substring to newString
-        pos = str.find( oldString, pos );
-        if( pos == std::string::npos ) break;
-        // Replace by erasing and inserting
-        str.erase( pos, oldString.length() );
-        str.insert( pos, newString );
+std::string replaceAll(std::string_view str, std::string_view oldString, std::string_view newString) {
+	if (oldString.empty())
+		return std::string(str);
 
-    }
+	std::string output;
+	output.reserve(str.size());
 
-	return str;
+	for (size_t pos = 0; ; ) {
+		size_t found = str.find(oldString, pos);
+		output.append(str.substr(pos, found - pos)); // Copies the rest once nothing's found.
+
+		if (found == std::string_view::npos)
+			break;
+
+		output.append(newString);
+		pos = found + oldString.size();
+	}
+
+	return output;
 }
 
 
-std::string replaceOnce(std::string str, std::string oldString, std::string newString) {
-	if (find(str, oldString))
-		str.replace(str.find(oldString), oldString.size(), newString);
+std::string replaceOnce(std::string_view str, std::string_view oldString, std::string_view newString) {
+	size_t pos = str.find(oldString);
+	std::string output(str);
 
-	return str;
+	if (pos != std::string_view::npos)
+		output.replace(pos, oldString.size(), newString);
+
+	return output;
 }
 
 
@@ -231,7 +431,7 @@ std::string convertBackslashes(std::string str) {
 			case '5':
 			case '6':
 			case '7':
-				int num;
+				unsigned int num;
 				sscanf(str.c_str(), "%o", &num);
 				str.replace(pos, 2, (&"\\"[num]));
 				break;
@@ -284,31 +484,40 @@ double eval(std::string expr, int& errorCode) {
 }
 
 
-std::string xToStr(allowedTypes val) {
-	if (std::holds_alternative<std::string>(val))
-		return std::get<std::string>(val);
+// Converts the element of a list or a map to a string, where strings keep their quotes.
+static std::string elementToStr(const HPL::variable& element) {
+	if (element.type == HPL::atom::STRING)
+		return '\"' + xToStr(element.value) + '\"';
 
-	else if (std::holds_alternative<int>(val))
-		return std::to_string(std::get<int>(val));
+	return xToStr(element.value);
+}
 
-	else if (std::holds_alternative<float>(val)) {
+
+std::string xToStr(const allowedTypes& val) {
+	if (val.index() == HPL::value::STRING)
+		return getStr(val);
+
+	else if (val.index() == HPL::value::INT)
+		return std::to_string(getInt(val));
+
+	else if (val.index() == HPL::value::FLOAT) {
 		std::ostringstream ss;
-		ss << std::get<float>(val);
+		ss << getFloat(val);
 
 		return ss.str();
 	}
 
-	else if (std::holds_alternative<bool>(val))
-		return std::get<bool>(val) == true ? "true" : "false";
+	else if (val.index() == HPL::value::BOOL)
+		return getBool(val) == true ? "true" : "false";
 
-	else if (std::holds_alternative<std::vector<HPL::variable>>(val)) {
+	else if (isVars(val)) {
 		std::string result = "{";
-		auto& _struct = std::get<std::vector<HPL::variable>>(val);
+		auto& _struct = getVars(val);
 
-		for (int i = 0; i < _struct.size(); i++) {
+		for (size_t i = 0; i < _struct.size(); i++) {
 			auto& member = _struct[i];
 
-			if (member.type == "string")
+			if (member.type == HPL::atom::STRING)
 				result += '\"' + xToStr(member.value) + '\"';
 			else
 				result += xToStr(member.value);
@@ -321,53 +530,225 @@ std::string xToStr(allowedTypes val) {
 		return result;
 	}
 
-	return std::string{};
-}
+	else if (isList(val)) {
+		std::string result = "{";
+		auto& items = getList(val);
 
+		for (size_t i = 0; i < items.size(); i++) {
+			result += elementToStr(items.at(i));
 
-bool typeIsValid(std::string type, HPL::structure*& info/* = NULL*/) {
-	if (coreTyped(type))
-		return true;
+			if (i + 1 < items.size())
+				result += ", ";
+		}
+		result += "}";
 
-	// Didn't find a core type, maybe it'll find a struct instead.
-	for (auto s : HPL::structures) {
-		if (type == s.name) {
-			if (info != nullptr)
-				info = &s;
-			return true;
+		return result;
+	}
+
+	else if (isMap(val)) {
+		std::string result = "{";
+		auto& entries = getMap(val);
+
+		for (size_t i = 0; i < entries.size(); i++) {
+			result += elementToStr(entries.keys.at(i)) + ": " + elementToStr(entries.values.at(i));
+
+			if (i + 1 < entries.size())
+				result += ", ";
 		}
+		result += "}";
+
+		return result;
 	}
 
-	return false; // Didn't find anything.
+	return std::string{};
 }
 
 
-bool coreTyped(std::string type) {
-	for (auto coreType : coreTypes) {
-		if (type == coreType) return true;
+bool typeIsValid(HPL::atom type, HPL::structure*& info/* = NULL*/) {
+	const HPL::typeInfo* t = HPL::findType(type);
+
+	if (t != nullptr && t->element != nullptr) { // Lists and maps are valid as long as their elements are.
+		HPL::structure* element = nullptr;
+		return typeIsValid(t->element->name, element);
 	}
 
-	return false;
+	if (t == nullptr || (!t->core && t->_struct == nullptr))
+		return false; // Didn't find anything.
+
+	if (!t->core && info != nullptr)
+		info = t->_struct;
+
+	return true;
+}
+
+
+bool coreTyped(HPL::atom type) {
+	const HPL::typeInfo* t = HPL::findType(type);
+	return t != nullptr && t->core;
+}
+
+
+const HPL::typeInfo* getListElement(HPL::atom type) {
+	const HPL::typeInfo* t = HPL::findType(type);
+	return (t != nullptr && t->key == nullptr ? t->element : nullptr);
+}
+
+
+const HPL::typeInfo* getMapKey(HPL::atom type) {
+	const HPL::typeInfo* t = HPL::findType(type);
+	return (t != nullptr ? t->key : nullptr);
 }
 
 
-std::string getTypeFromValue(std::string value) {
+HPL::atom getTypeFromValue(std::string_view value) {
 	if (isStr(value))
-		return "string";
+		return HPL::atom::STRING;
 	else if (isInt(value) && !find(value, "."))
-		return "int";
+		return HPL::atom::INT;
 	else if (isInt(value) && find(value, "."))
-		return "float";
+		return HPL::atom::FLOAT;
 	else if (value == "true" || value == "false")
-		return "bool";
+		return HPL::atom::BOOL;
 	else if (value.front() == '{' && value.back() == '}')
-		return "struct";
+		return HPL::atom::STRUCT;
 	else if (value == "==" || value == "!=" || value == ">=" || value == "<=" || value == "<" || value == ">")
-		return "relational-operator";
+		return HPL::atom::RELATIONAL_OPERATOR;
 	else if (value == "&&" || value == "||")
-		return "logical-operator";
+		return HPL::atom::LOGICAL_OPERATOR;
 
-	return std::string{};
+	return HPL::atom::NONE;
+}
+
+
+bool isOperator(const HPL::expression& expr, HPL::atom kind) {
+	return expr.constant != -1 && HPL::constants[expr.constant].value.type == kind;
+}
+
+
+std::string joinStrings(const std::string& value) {
+	auto plusShenanigans = split(value, "+", "\"\"(){}"); // C's '+' strike again! We gotta organize everything ffs.
+	std::string res;
+
+	for (const auto& sentence : plusShenanigans) {
+		std::string output(removeFrontAndBackSpaces(sentence));
+
+		if (!isStr(output)) {
+			HPL::variable uselessVar;
+
+			setCorrectValue(uselessVar, output, false);
+			output = xToStr(uselessVar.value);
+		}
+
+		res += unstringify(output);
+	}
+
+	return convertBackslashes(res);
+}
+
+
+// Replaces every '{value}' inside of the f-string with the actual value and removes the 'f'.
+static std::string fillFstring(std::string ogValue, const std::vector<HPL::expression>& values) {
+	ogValue.erase(0, 1); // Remove the F letter.
+
+	for (const auto& value : values) {
+		HPL::variable var;
+		bool res = evaluateExpression(var, value, false);
+
+		if (!res) // Can't use f-string without providing any valid value obviously...
+			HPL::throwError(true, "Argument '%s' is invalid (Either it's a variable that doesn't exist or something else entirely)", value.text.c_str());
+		else
+			ogValue = replaceOnce(ogValue, "{" + value.text + "}", xToStr(var.value));
+	}
+
+	return ogValue;
+}
+
+
+// Sets the value to a struct made out of the members.
+static void setStructValue(HPL::variable& var, const std::vector<HPL::expression>& members) {
+	HPL::structure* _struct = getStructFromName(var.type);
+	std::vector<HPL::variable> output;
+	size_t index = 0;
+
+	for (const auto& v : members) {
+		HPL::variable coreTypedVariable;
+
+		if (_struct != nullptr && index < _struct->value.size())
+			coreTypedVariable = _struct->value[index];
+
+		if (evaluateExpression(coreTypedVariable, v, false))
+			output.push_back(coreTypedVariable);
+		else
+			HPL::throwError(true, "Variable '%s' doesn't exist (Cannot set a member to something that doesn't exist)", v.text.c_str());
+
+		index++;
+	}
+
+	if (_struct != nullptr && _struct->value.size() > index + 1) {
+		for (size_t i = index; i < _struct->value.size(); i++) {
+			output.push_back(_struct->value[i]);
+		}
+	}
+
+	var.value = std::move(output);
+
+	if (var.type.empty())
+		var.type = HPL::atom::STRUCT; // We'll deal with this later in the code.
+}
+
+
+// Sets the value to a list made out of the elements.
+static void setListValue(HPL::variable& var, const std::vector<HPL::expression>& elements) {
+	HPL::list items(getListElement(var.type)->name);
+
+	for (const auto& e : elements) {
+		HPL::variable element = {.type = items.type};
+
+		if (!evaluateExpression(element, e, true))
+			HPL::throwError(true, "Cannot put '%s' into a list of %s (Either it's a variable that doesn't exist or it isn't %s-typed).", e.text.c_str(), items.type.c_str(), items.type.c_str());
+
+		items.push_back(element);
+	}
+
+	var.value = std::move(items);
+}
+
+
+// Sets the value to a map made out of the '<key>: <element>' pairs.
+static void setMapValue(HPL::variable& var, const std::vector<HPL::expression>& pairs) {
+	HPL::map entries(getMapKey(var.type)->name, HPL::findType(var.type)->element->name);
+
+	for (const auto& pair : pairs) {
+		HPL::variable key = {.type = entries.keys.type}, element = {.type = entries.values.type};
+
+		if (pair.type != HPL::EXPRESSION_PAIR)
+			HPL::throwError(true, "Invalid element '%s' in map '%s' (format is '<key>: <value>').", pair.text.c_str(), var.name.c_str());
+
+		const HPL::expression& keyExpr = pair.args[0];
+		const HPL::expression& elementExpr = pair.args[1];
+
+		if (!evaluateExpression(key, keyExpr, true))
+			HPL::throwError(true, "Cannot use '%s' as a key of a map (Either it's a variable that doesn't exist or it isn't %s-typed).", keyExpr.text.c_str(), key.type.c_str());
+		if (!evaluateExpression(element, elementExpr, true))
+			HPL::throwError(true, "Cannot put '%s' into a map of %s (Either it's a variable that doesn't exist or it isn't %s-typed).", elementExpr.text.c_str(), element.type.c_str(), element.type.c_str());
+
+		entries.values.set(entries.insert(key), element);
+	}
+
+	var.value = std::move(entries);
+}
+
+
+static void logCorrectValue(const std::string& value, HPL::variable& var, HPL::variable* existingVar, bool result) {
+	if (HPL::arg.debugAll || HPL::arg.debugLog) {
+		std::string buffer;
+		if (existingVar)
+			buffer = printVar(*existingVar) + " (" + (result ? "true" : "false") + ")";
+		else
+			buffer = printVar(var) + " (" + (result ? "true" : "false") + ")";
+
+		std::cout << HPL::arg.curIndent  << HPL::colorText("LOG: [FUNCTION][SET-CORRECT-VALUE]: ", HPL::OUTPUT_PURPLE) << HPL::curFile << ":" << HPL::lineCount << ": <og value> = <info> (<is set>): " << value << " = " << buffer << std::endl;
+	}
 }
 
 
@@ -397,11 +778,18 @@ bool setCorrectValue(HPL::variable& var, std::string value, bool onlyChangeValue
 		}
 	}*/
 
-	if ((var.type.empty() || var.type == "auto") && existingVar == nullptr)
+	if ((var.type.empty() || var.type == HPL::atom::AUTO) && existingVar == nullptr)
 		var.type = getTypeFromValue(value);
 
-	if (value.empty() && existingVar == nullptr && var.type != "scope" && typeIsValid(var.type, s))
+	if (value.empty() && existingVar == nullptr && var.type != HPL::atom::SCOPE && typeIsValid(var.type, s)) {
+		// Lists and maps start out empty instead of without a value.
+		if (const HPL::typeInfo* element = getListElement(var.type))
+			var.value = HPL::list(element->name);
+		else if (const HPL::typeInfo* key = getMapKey(var.type))
+			var.value = HPL::map(key->name, HPL::findType(var.type)->element->name);
+
 		return false;
+	}
 
 	if (existingVar != nullptr) {
 		if (!onlyChangeValue)
@@ -428,10 +816,10 @@ bool setCorrectValue(HPL::variable& var, std::string value, bool onlyChangeValue
 			}
 
 			// The first removes the spaces, then the double quotes.
-			for (int i = 0; i < s->value.size(); i++) {
+			for (size_t i = 0; i < s->value.size(); i++) {
 				if (i < s->value.size() && i < valueList.size()) {
 					HPL::variable var;
-					setCorrectValue(var, removeFrontAndBackSpaces(valueList[i]), true);
+					setCorrectValue(var, std::string(removeFrontAndBackSpaces(valueList[i])), true);
 
 					result.push_back(var);
 				}
@@ -452,221 +840,466 @@ bool setCorrectValue(HPL::variable& var, std::string value, bool onlyChangeValue
 	if (s != nullptr || existingVar != nullptr) {
 		result = true;
 	}
-	else if (var.type == "scope") {
+	else if (var.type == HPL::atom::SCOPE) { // Scopes with HSM code are handled by 'HPL::interpreteScope'.
 		var.reset_value();
-
-		if (!(value == "{}" || value.empty())) {
-			HPL::mode = (value == "{" ? MODE_SAVE_SCOPE : MODE_CHECK_SCOPE);
-			HPL::variables[0].value = true; // Scope mode is ON!
-		}
-
 		result = true;
 	}
 
-	else if (var.type == "string" && isStr(value)) {
+	else if (var.type == HPL::atom::STRING && isStr(value)) {
 		getValueFromFstring(value, value);
 
-		auto plusShenanigans = split(value, "+", "\"\"(){}"); // C's '+' strike again! We gotta organize everything ffs.
-		std::string res;
-
-		for (const auto& sentence : plusShenanigans) {
-			std::string output = removeFrontAndBackSpaces(sentence);
-
-			if (!isStr(output)) {
-				HPL::variable uselessVar;
-
-				setCorrectValue(uselessVar, output, false);
-				output = xToStr(uselessVar.value);
-			}
-
-			res += unstringify(output);
-		}
-
-		var.value = convertBackslashes(res);
+		var.value = joinStrings(value);
 		result = true;
 	}
 
 	else if (isInt(value)) {
-		if (var.type == "int") {
+		if (var.type == HPL::atom::INT) {
 			var.value = xToType<int>(value);
 			result = true;
 		}
 
-		else if (var.type == "float") {
+		else if (var.type == HPL::atom::FLOAT) {
 			var.value = xToType<float>(value);
 			result = true;
 		}
 	}
 
-	else if (var.type == "bool") {
+	else if (var.type == HPL::atom::BOOL) {
 		var.value = stringToBool(value);
 		result = true;
 	}
 
-	else if (var.type == "struct" || (value.front() == '{' && value.back() == '}')) {
-		useIterativeRegex(unstringify(value, true), R"(([^\,\s]+))"); // get the members.
+	else if (getListElement(var.type) != nullptr && value.front() == '{' && value.back() == '}') {
+		setListValue(var, HPL::parseExpression(value).args);
+		result = true;
+	}
+
+	else if (getMapKey(var.type) != nullptr && value.front() == '{' && value.back() == '}') {
+		setMapValue(var, HPL::parseExpression(value).args);
+		result = true;
+	}
+
+	else if (var.type == HPL::atom::STRUCT || (value.front() == '{' && value.back() == '}')) {
+		std::string members(unstringify(value, true));
+		useIterativeRegex(members, R"(([^\,\s]+))"); // get the members.
 
-		HPL::structure* _struct = getStructFromName(var.type);
-		std::vector<HPL::variable> output;
-		auto oldMatches = HPL::matches.value;
-		int index = 0;
+		std::vector<std::string> oldMatches(HPL::matches.value.begin(), HPL::matches.value.end());
+		std::vector<HPL::expression> output;
 
-		for (auto& v : oldMatches) {
-			HPL::variable* var = getVarFromName(v);
-			HPL::variable coreTypedVariable;
+		for (const auto& v : oldMatches)
+			output.push_back(HPL::parseExpression(v));
 
-			if (_struct != nullptr)
-				coreTypedVariable = _struct->value[index];
+		setStructValue(var, output);
+		result = true;
+	}
+	else if (matchFunctionCall(value)) {
+		assignFuncReturnToVar(&var, HPL::parseCall(HPL::matches.view(1), HPL::matches.view(2)));
+		result = true;
+	}
+	/*else if (!(result = extractMathFromValue(value, existingVar)).empty()) // A math expresultsion.
+		value = result;*/
 
-			if (var != nullptr)
-				output.push_back(*var);
+	else if (var.type == HPL::atom::RELATIONAL_OPERATOR || var.type == HPL::atom::LOGICAL_OPERATOR) {
+		var.value = value;
+		result = true;
+	}
 
-			else if (setCorrectValue(coreTypedVariable, v, false))
-				output.push_back(coreTypedVariable);
+	logCorrectValue(value, var, existingVar, result);
+
+	return result;
+}
 
-			else if (v.empty() && _struct != nullptr)
-				output.push_back(_struct->value[index]);
-			
-			else if (v.empty())
-				output.push_back({});
 
+bool evaluateExpression(HPL::variable& var, const HPL::expression& expr, bool onlyChangeValue) {
+	bool autoType = (var.type.empty() || var.type == HPL::atom::AUTO);
+
+	// The value is already known to be a specific kind, so only the checks
+	// that 'setCorrectValue' would do for it are done. Anything out of the
+	// ordinary (eg. a string assigned to an int) goes through 'setCorrectValue'.
+	switch (expr.type) {
+		case HPL::EXPRESSION_VARIABLE: {
+			if (expr.members == nullptr && expr.text.find('.') != std::string::npos)
+				expr.members = std::make_shared<HPL::memberCache>();
+
+			HPL::variable* existingVar = (expr.members != nullptr ? getVarFromName(expr.text, *expr.members) : getVarFromName(expr.text));
+
+			if (existingVar == nullptr)
+				break;
+
+			if (!onlyChangeValue)
+				var = *existingVar;
 			else
-				HPL::throwError(true, "Variable '%s' doesn't exist (Cannot set a member to something that doesn't exist)", v.c_str());
+				var.value = existingVar->value;
 
-			index++;
+			logCorrectValue(expr.text, var, existingVar, true);
+			return true;
 		}
 
-		if (_struct != nullptr && _struct->value.size() > index + 1) {
-			for (int i = index; i < _struct->value.size(); i++) {
-				output.push_back(_struct->value[i]);
-			}
+		case HPL::EXPRESSION_INDEX: {
+			listElement element;
+			HPL::variable* existingVar = findElement(expr, element);
+
+			if (existingVar == nullptr)
+				break;
+
+			if (!onlyChangeValue)
+				var = *existingVar;
+			else
+				var.value = existingVar->value;
+
+			logCorrectValue(expr.text, var, existingVar, true);
+			return true;
 		}
 
-		var.value = output;
+		case HPL::EXPRESSION_STRING:
+		case HPL::EXPRESSION_FSTRING:
+			if (!autoType && var.type != HPL::atom::STRING)
+				break;
+
+			var.type = HPL::atom::STRING;
 
-		if (var.type.empty())
-			var.type = "struct"; // We'll deal with this later in the code.
+			if (expr.type == HPL::EXPRESSION_FSTRING)
+				var.value = joinStrings(fillFstring(expr.text, expr.args));
+			else
+				var.value = HPL::constants[expr.constant].value.value;
 
-		result = true;
+			logCorrectValue(expr.text, var, nullptr, true);
+			return true;
+
+		case HPL::EXPRESSION_NUMBER: {
+			const HPL::constant& number = HPL::constants[expr.constant];
+
+			if (autoType)
+				var.type = number.value.type;
+
+			if (var.type == number.value.type)
+				var.value = number.value.value;
+			else if (var.type == number.other.type)
+				var.value = number.other.value;
+			else
+				break;
+
+			logCorrectValue(expr.text, var, nullptr, true);
+			return true;
+		}
+
+		case HPL::EXPRESSION_BOOL:
+			if (!autoType && var.type != HPL::atom::BOOL)
+				break;
+
+			var.type = HPL::atom::BOOL;
+			var.value = HPL::constants[expr.constant].value.value;
+
+			logCorrectValue(expr.text, var, nullptr, true);
+			return true;
+
+		case HPL::EXPRESSION_STRUCT:
+			if (var.type == HPL::atom::BOOL || var.type == HPL::atom::SCOPE)
+				break;
+
+			if (getListElement(var.type) != nullptr || getMapKey(var.type) != nullptr) {
+				if (getListElement(var.type) != nullptr)
+					setListValue(var, expr.args);
+				else
+					setMapValue(var, expr.args);
+
+				logCorrectValue(expr.text, var, nullptr, true);
+				return true;
+			}
+
+			if (autoType)
+				var.type = HPL::atom::STRUCT;
+
+			setStructValue(var, expr.args);
+
+			logCorrectValue(expr.text, var, nullptr, true);
+			return true;
+
+		case HPL::EXPRESSION_CALL:
+			if (var.type == HPL::atom::BOOL || var.type == HPL::atom::SCOPE || var.type == HPL::atom::STRUCT)
+				break;
+
+			if (autoType)
+				var.type.clear();
+
+			assignFuncReturnToVar(&var, expr);
+
+			logCorrectValue(expr.text, var, nullptr, true);
+			return true;
+
+		default:
+			break;
 	}
-	else if (useRegex(value, R"(^\s*([^\s\(]+)\((.*)\)\s*$)")) {
-		assignFuncReturnToVar(&var, HPL::matches.str(1), HPL::matches.str(2));
-		result = true;
+
+	return setCorrectValue(var, expr.text, onlyChangeValue);
+}
+
+
+void setStructDefaults(HPL::variable& var) {
+	if (isVars(var.value) && getVars(var.value).empty()) {
+		HPL::structure* s = getStructFromName(var.type);
+		if (s != nullptr)
+			var.value = s->defaults;
 	}
-	/*else if (!(result = extractMathFromValue(value, existingVar)).empty()) // A math expresultsion.
-		value = result;*/
+}
 
-	else if (var.type == "relational-operator" || var.type == "logical-operator") {
-		var.value = value;
-		result = true;
+
+HPL::variable* getVarFromName(std::string varName, bool write) {
+	// Only struct members have to be searched for, everything else is found by its hashed name.
+	if (!find(varName, ".")) {
+		HPL::atom name;
+		HPL::variable* v = (HPL::atom::find(varName, name) ? HPL::variables.find(name) : nullptr);
+
+		if (v != nullptr)
+			setStructDefaults(*v);
+
+		return v;
 	}
 
-	if (HPL::arg.debugAll || HPL::arg.debugLog) {
-		std::string buffer;
-		if (existingVar)
-			buffer = printVar(*existingVar) + " (" + (result ? "true" : "false") + ")";
+	// A name that was never interned can't be a variable or a member.
+	HPL::memberCache cache;
+	bool first = true;
+
+	for (const auto& name : split(varName, ".")) {
+		HPL::atom id;
+		if (!HPL::atom::find(name, id))
+			return nullptr;
+
+		if (first)
+			cache.base = id;
 		else
-			buffer = printVar(var) + " (" + (result ? "true" : "false") + ")";
+			cache.path.push_back(id);
+		first = false;
+	}
 
-		std::cout << HPL::arg.curIndent  << HPL::colorText("LOG: [FUNCTION][SET-CORRECT-VALUE]: ", HPL::OUTPUT_PURPLE) << HPL::curFile << ":" << HPL::lineCount << ": <og value> = <info> (<is set>): " << value << " = " << buffer << std::endl;
+	HPL::variable* v = HPL::variables.find(cache.base);
+	return (v != nullptr ? getMember(*v, cache, write) : nullptr);
+}
+
+
+HPL::variable* getVarFromName(const std::string& varName, HPL::memberCache& cache, bool write) {
+	if (cache.base.empty()) {
+		auto names = split(varName, ".");
+
+		cache.base = HPL::atom(names[0]);
+		for (size_t i = 1; i < names.size(); i++)
+			cache.path.push_back(HPL::atom(names[i]));
 	}
 
-	return result;
+	HPL::variable* v = HPL::variables.find(cache.base);
+
+	if (v == nullptr)
+		return nullptr;
+	if (cache.path.empty()) {
+		setStructDefaults(*v);
+		return v;
+	}
+
+	return getMember(*v, cache, write);
 }
 
 
-HPL::variable* getVarFromName(std::string varName) {
-	for (auto& v : HPL::variables) {
-		if (v.name == varName) {
-			auto value = xToStr(v.value);
+HPL::variable* getMember(HPL::variable& var, HPL::memberCache& cache, bool write) {
+	const HPL::typeInfo* t = HPL::findType(var.type);
 
-			if (value == "{}") {
-				HPL::structure* s = getStructFromName(v.type);
-				if (s != nullptr)
-					v.value = s->value;
-			}
+	if (t == nullptr || t->_struct == nullptr)
+		return nullptr;
 
-			return &v;
-		}
+	// Every struct's members are in a fixed order, so the path only has to be resolved once per type.
+	if (cache.type != t->id || cache.epoch != HPL::structEpoch) {
+		HPL::structure* s = t->_struct;
+
+		cache.type = -1;
+		cache.members.clear();
 
-		if (find(varName, v.name + ".")) { // A custom type
-			HPL::structure* s = getStructFromName(v.type);
+		for (const auto& name : cache.path) {
+			size_t index = 0;
 
-			if (s == nullptr) // Was a false-positive after all, goddamn...
+			if (s == nullptr)
 				return nullptr;
 
-			auto listOfMembers = split(varName, ".", "(){}\"\"");
-			auto pointer = &v.value;
-
-			std::string baseName;
-			std::string baseType, oldBaseType = v.type;
-
-			for (int memberIndex = 0; memberIndex < listOfMembers.size(); memberIndex++) {
-				baseName += listOfMembers[memberIndex] + ".";
-
-				for (int varIndex = 0; varIndex < s->value.size(); varIndex++) {
-					auto& member = s->value[varIndex];
-					baseType = member.type;
-
-
-					if (find(varName, (baseName + member.name))) {
-						if (varName == (baseName + member.name)) {
-							if (v.has_value()) {
-								auto& values = getVars(*pointer);
-								HPL::variable* valueLocation;
-								std::string value;
-
-								if (varIndex < values.size())
-									valueLocation = &values[varIndex];
-								else
-									valueLocation = &s->value[varIndex];
-
-								value = xToStr(valueLocation->value);
-
-								valueLocation->name = member.name;
-
-								if (value == "{}")
-									valueLocation->value = s->value[varIndex].value;
-
-								return valueLocation;
-							}
-							else {
-								auto* valueLocation = &s->value[varIndex];
-								valueLocation->name = member.name;
-
-								return valueLocation;
-							}
-						}
-						else {
-							s = getStructFromName(member.type);
-							if (v.has_value()) {
-								std::vector<HPL::variable>& varValues = getVars(v.value);
-								pointer = &varValues[varIndex].value;
-							}
-							else {
-								v.value = std::vector<HPL::variable>{};
-								std::vector<HPL::variable>& varValues = getVars(v.value);
-								pointer = &varValues[varIndex].value;
-							}
-							varIndex = 0;
-						}
-					}
-				}
-			}
+			while (index < s->value.size() && s->value[index].name != name)
+				index++;
+
+			if (index == s->value.size())
+				return nullptr;
+
+			cache.members.push_back({s, (int)index});
+			s = getStructFromName(s->value[index].type);
 		}
+
+		cache.type = t->id;
+		cache.epoch = HPL::structEpoch;
 	}
 
-	return nullptr;
+	HPL::variable* current = &var;
+	HPL::variable* member = nullptr;
+	bool shared = false;
+
+	for (auto [s, index] : cache.members) {
+		member = &s->value[index];
+
+		// The struct's defaults are only copied once one of its members gets written,
+		// as the defaults themselves must stay the same for every other variable.
+		if (write) {
+			if (!isVars(current->value) || getVars(current->value).empty())
+				current->value = s->defaults;
+
+			// Members that are shared with other variables (or the defaults) get copied here.
+			auto& members = current->value.vars();
+			for (size_t i = members.size(); i < s->value.size(); i++)
+				members.push_back(s->value[i]);
+
+			current = &members[index];
+			continue;
+		}
+
+		// Members that were never set are read from the struct's defaults. Reading doesn't
+		// copy shared members, as the caller only copies the found member.
+		if (isVars(current->value) && (size_t)index < getVars(current->value).size())
+			current = const_cast<HPL::variable*>(&getVars(current->value)[index]);
+		else {
+			current = member;
+			shared = true;
+		}
+	}
+
+	if (member == nullptr || shared)
+		return current;
+
+	current->name = member->name;
+
+	if (isVars(current->value) && getVars(current->value).empty()) {
+		if (!write)
+			return member;
+		current->value = member->value;
+	}
+
+	return current;
+}
+
+
+void structToList(HPL::variable& var, HPL::atom type) {
+	HPL::variable items = {.type = type, .name = var.name, .value = HPL::list(getListElement(type)->name)};
+
+	for (const auto& member : getVars(var.value))
+		HPL::doMath(items, "+=", &member);
+
+	var = std::move(items);
 }
 
 
-HPL::structure* getStructFromName(std::string name) {
-	for (auto& s : HPL::structures) {
-		if (s.name == name)
-			return &s;
+HPL::variable* findElement(const HPL::expression& expr, listElement& element, bool write) {
+	HPL::variable index;
+
+	// The index is evaluated first, as a call inside of it might move the variables.
+	if (!evaluateExpression(index, expr.args[0], false))
+		HPL::throwError(true, "Variable '%s' doesn't exist (Cannot use something that doesn't exist as an index or a key).", expr.args[0].text.c_str());
+
+	if (expr.members == nullptr)
+		expr.members = std::make_shared<HPL::memberCache>();
+
+	HPL::variable* var = getVarFromName(expr.name, *expr.members, write);
+
+	if (var == nullptr)
+		return nullptr;
+
+	static const HPL::list none;
+	const HPL::list* items = &none;
+	const HPL::typeInfo* key = getMapKey(var->type);
+	int i = -1;
+
+	if (key != nullptr) {
+		if (index.type != key->name)
+			HPL::throwError(true, "Key '%s' isn't %s-typed (The keys of map '%s' are %s-typed).", expr.args[0].text.c_str(), key->name.c_str(), expr.name.c_str(), key->name.c_str());
+
+		if (isMap(var->value))
+			i = getMap(var->value).find(index.value);
+
+		if (i == -1 && !write)
+			HPL::throwError(true, "Key '%s' doesn't exist (Map '%s' doesn't have it).", xToStr(index.value).c_str(), expr.name.c_str());
+
+		if (i == -1) {
+			if (!isMap(var->value))
+				var->value = HPL::map(key->name, HPL::findType(var->type)->element->name);
+
+			i = var->value.entries().insert(index);
+		}
+
+		items = &getMap(var->value).values;
+	}
+	else if (getListElement(var->type) != nullptr) {
+		if (index.type != HPL::atom::INT)
+			HPL::throwError(true, "Index '%s' isn't an int (Lists can only be indexed with ints).", expr.args[0].text.c_str());
+
+		if (isList(var->value))
+			items = &getList(var->value);
+
+		i = getInt(index.value);
+
+		if (i < 0 || (size_t)i >= items->size())
+			HPL::throwError(true, "Index %i is out of range (List '%s' has %i elements).", i, expr.name.c_str(), (int)items->size());
+	}
+	else
+		HPL::throwError(true, "Variable '%s' isn't a list or a map (Cannot index a %s-typed variable).", expr.name.c_str(), var->type.c_str());
+
+	element.source = &expr;
+	element.index = i;
+
+	if (expr.args.size() < 2) {
+		element.value = items->at(i);
+		element.value.name = HPL::atom(expr.text);
+
+		return &element.value;
+	}
+
+	// Only the column of the first member is loaded, the rest of the path is inside of it.
+	const HPL::expression& member = expr.args[1];
+
+	if (member.members == nullptr) {
+		auto names = split(member.text, ".");
+		member.members = std::make_shared<HPL::memberCache>();
+
+		member.members->base = HPL::atom(names[0]);
+		for (size_t n = 1; n < names.size(); n++)
+			member.members->path.push_back(HPL::atom(names[n]));
 	}
 
-	return nullptr;
+	element.column = items->column(member.members->base);
+
+	if (element.column == -1)
+		HPL::throwError(true, "Member '%s' doesn't exist (The elements of '%s' are %s-typed).", member.text.c_str(), expr.name.c_str(), items->type.c_str());
+
+	element.value = items->shape->value[element.column];
+	element.value.value = items->columns[element.column][i];
+
+	if (member.members->path.empty())
+		return &element.value;
+
+	HPL::variable* found = getMember(element.value, *member.members, write);
+
+	if (found == nullptr)
+		HPL::throwError(true, "Member '%s' doesn't exist (The elements of '%s' are %s-typed).", member.text.c_str(), expr.name.c_str(), items->type.c_str());
+
+	return found;
+}
+
+
+void storeElement(listElement& element) {
+	// The list is found again, as evaluating the new value might've moved the variables.
+	HPL::variable* var = getVarFromName(element.source->name, *element.source->members, true);
+	HPL::list& items = (isMap(var->value) ? var->value.entries().values : var->value.items());
+
+	if (element.column == -1)
+		items.set(element.index, element.value);
+	else
+		items.columns[element.column][element.index] = std::move(element.value.value);
+}
+
+
+HPL::structure* getStructFromName(HPL::atom name) {
+	const HPL::typeInfo* t = HPL::findType(name);
+	return (t != nullptr ? t->_struct : nullptr);
 }
 
 
@@ -675,21 +1308,13 @@ int getValueFromFstring(std::string ogValue, std::string& output) {
 	if (ogValue.front() == 'f' && ogValue[1] == '\"' && ogValue.back() == '\"') {
 		// Get every match of {words inside curly brackets}.
 		useIterativeRegex(ogValue, R"(\{([\w\(\)\[\]\.]+)\})");
-		ogValue.erase(0, 1); // Remove the F letter.
-
+		std::vector<std::string> matches(HPL::matches.value.begin(), HPL::matches.value.end());
+		std::vector<HPL::expression> values;
 
-		for (auto value : HPL::matches.value) {
-			HPL::variable var;
-			bool res = setCorrectValue(var, value, false);
+		for (const auto& value : matches)
+			values.push_back(HPL::parseExpression(value));
 
-			if (!res) // Can't use f-string without providing any valid value obviously...
-				HPL::throwError(true, "Argument '%s' is invalid (Either it's a variable that doesn't exist or something else entirely)", value.c_str());
-			else {
-				value = "{" + value + "}";
-				ogValue = replaceOnce(ogValue, value, xToStr(var.value));
-			}
-		}
-		output = ogValue;
+		output = fillFstring(ogValue, values);
 
 		return 0;
 	}
@@ -702,9 +1327,9 @@ std::string extractMathFromValue(std::string expr, HPL::variable* var) {
 	double res = eval(expr, mathError);
 
 	if (mathError != -1) { // Actual math is in the value.
-		if (var->type == "int")
+		if (var->type == HPL::atom::INT)
 			return std::to_string((int)res);
-		else if (var->type == "float")
+		else if (var->type == HPL::atom::FLOAT)
 			return std::to_string((float)res);
 	}
 
@@ -715,13 +1340,13 @@ std::string extractMathFromValue(std::string expr, HPL::variable* var) {
 std::string printFunction(HPL::function func) {
 	std::string str = func.type + " " + func.name + "(";
 
-	for (int i = 0; i < func.params.size(); i++) {
+	for (size_t i = 0; i < func.params.size(); i++) {
 		auto& p = func.params[i];
 		str += p.type + " " + p.name;
 
 		if (p.has_value()) {
 			str += " = ";
-			if (p.type == "string")
+			if (p.type == HPL::atom::STRING)
 				str += '\"' + xToStr(p.value) + '\"';
 			else
 				str += xToStr(p.value);
@@ -735,12 +1360,12 @@ std::string printFunction(HPL::function func) {
 }
 
 
-std::string printVar(HPL::variable var) {
+std::string printVar(const HPL::variable& var) {
 	std::string str = var.type + " " + var.name;
 
 	if (var.has_value()) {
 		str += " = ";
-		if (var.type == "string")
+		if (var.type == HPL::atom::STRING)
 			str += "\"" + replaceAll(xToStr(var.value), R"(\)", "\\") + "\"";
 		else
 			str += replaceAll(xToStr(var.value), R"(\)", "\\");
@@ -27,20 +27,52 @@
 #include <helper.hpp>
 
 #include <iostream>
+#include <cctype>
 
 
-std::string HSM::interpreteLine(std::string str) {
+// Removes the whitespace in the front and back, without copying the line.
+static std::string_view trim(std::string_view str) {
+	while (!str.empty() && std::isspace((unsigned char)str.front()))
+		str.remove_prefix(1);
+	while (!str.empty() && std::isspace((unsigned char)str.back()))
+		str.remove_suffix(1);
+
+	return str;
+}
+
+
+// Same as the regex '^\s*if\s*(.*)\s*$'.
+static bool matchIf(std::string_view str) {
+	HPL::matches.clear();
+
+	while (!str.empty() && std::isspace((unsigned char)str.front()))
+		str.remove_prefix(1);
+
+	if (str.substr(0, 2) != "if" || str.find('\n') != std::string_view::npos)
+		return false;
+
+	str.remove_prefix(2);
+	while (!str.empty() && std::isspace((unsigned char)str.front()))
+		str.remove_prefix(1);
+
+	HPL::matches.push_back(str);
+	return true;
+}
+
+
+std::string HSM::interpreteLine(std::string_view str) {
 	std::string buffer;
 	std::string tabs;
 	bool found = false;
 
-	if (find(str, "#")) // Ignore comments
-		str = split(str, "#", "\"\"")[0];
-
 	line = str;
 
-	bool leftBracket = useRegex(line, R"(^\s*(\})\s*$)");
-	bool rightBracket = useRegex(line, R"(^.*\s*\=\s*\{\s*$)");
+	if (line.find('#') != std::string::npos) // Ignore comments
+		line = split(line, "#", "\"\"")[0];
+
+	std::string_view trimmed = trim(line);
+	bool leftBracket = (trimmed == "}");
+	bool rightBracket = (trimmed.size() >= 2 && trimmed.back() == '{' && trim(trimmed.substr(0, trimmed.size() - 1)).back() == '=');
 
 
 	if (leftBracket)
@@ -62,19 +94,9 @@ std::string HSM::interpreteLine(std::string str) {
 	if (!found)
 		buffer += line;
 
-	if (leftBracket && equalBrackets == 0) {
-		HPL::mode = MODE_DEFAULT;
-		HPL::variables[0].value = false;
-
-		auto& value = getStr(HPL::variables[HPL::scopeIndex].value);
-		value.pop_back();
-
-		return std::string{};
-	}
-	else
-		buffer += "\n";
+	buffer += "\n";
 
-	buffer = tabs + removeFrontAndBackSpaces(buffer);
+	buffer = tabs.append(removeFrontAndBackSpaces(buffer));
 
 
 	return buffer;
@@ -82,11 +104,11 @@ std::string HSM::interpreteLine(std::string str) {
 
 
 int HSM::checkConditions(std::string& buffer) {
-	if (useRegex(line, R"(^\s*if\s*(.*)\s*$)")) {
-		std::string oldValue = removeFrontAndBackSpaces(HPL::matches.str(1));
+	if (matchIf(line)) {
+		std::string_view oldValue = removeFrontAndBackSpaces(HPL::matches.view(1)); // Points into the line.
 
-		if (oldValue.back() == '{') {
-			oldValue.pop_back();
+		if (!oldValue.empty() && oldValue.back() == '{') {
+			oldValue.remove_suffix(1);
 		}
 		else {
 			//HPL::mode = MODE_CHECK_IF_STATEMENT;
@@ -102,7 +124,7 @@ int HSM::checkConditions(std::string& buffer) {
 		buffer += "if = {\n\tlimit = {";
 		equalBrackets++;
 
-		for (int i = 0; i < params.size(); i++) {
+		for (size_t i = 0; i < params.size(); i++) {
 			auto& p = params[i];
 			p = removeFrontAndBackSpaces(p);
 
@@ -177,11 +199,11 @@ int HSM::checkConditions(std::string& buffer) {
 
 
 int HSM::checkFunctions(std::string& buffer) {
-	if (useRegex(line, R"(^\s*([^\s\(]+)\((.*)\)\s*$)") && HPL::matches.size() == 2) {
+	if (matchFunctionCall(line)) {
 		HPL::function f; HPL::variable res;
 
 		if (HPL::arg.debugAll || HPL::arg.debugLog) {
-			std::cout << HPL::arg.curIndent << "HSM: LOG: [USE][FUNCTION]: " << HPL::curFile << ":" << HPL::lineCount << ": <name>(<params>): " << HPL::matches.str(1) << "(" << HPL::matches.str(2) << ")" << std::endl;
+			std::cout << HPL::arg.curIndent << "HSM: LOG: [USE][FUNCTION]: " << HPL::curFile << ":" << HPL::lineCount << ": <name>(<params>): " << HPL::matches.view(1) << "(" << HPL::matches.view(2) << ")" << std::endl;
 		}
 
 		executeFunction(HPL::matches.str(1), HPL::matches.str(2), f, res);
@@ -23,17 +23,22 @@
 #define _CRT_SECURE_NO_WARNINGS
 
 #include <interpreter.hpp>
+#include <parser.hpp>
 #include <core.hpp>
 #include <helper.hpp>
 #include <functions.hpp>
+#include <vm.hpp>
+#include <cache.hpp>
+#include <corelib.hpp>
+#include <arena.hpp>
 
 #include <scope/hoi4scripting.hpp>
 
 #include <iostream>
+#include <unordered_map>
 #include <string.h>
 #include <math.h>
-
-std::vector<std::string> alreadyReadFiles;
+#include <stdarg.h>
 
 std::string HPL::colorText(std::string txt, RETURN_OUTPUT type, bool light/* = false*/) {
 	#if defined(WIN32) || defined(_WIN32) || defined(__WIN32) && !defined(__CYGWIN__)
@@ -82,581 +87,657 @@ std::string HPL::colorText(std::string txt, RETURN_OUTPUT type, bool light/* = f
 }
 
 
+// Finds the built in core library that the 'core/<name>' path is for.
+static const HPL::coreLibrary* findCoreLibrary(const std::string& file) {
+	if (HPL::arg.diskCore || file.compare(0, 5, "core/") != 0)
+		return nullptr;
+
+	for (size_t i = 0; i < HPL::coreLibraryCount; i++) {
+		if (file.compare(5, std::string::npos, HPL::coreLibraries[i].name) == 0)
+			return &HPL::coreLibraries[i];
+	}
+
+	return nullptr;
+}
+
+
+HPL::program* HPL::loadProgram(const std::string& file) {
+	program& prog = programs.emplace_back();
+	prog.file = file;
+
+	const coreLibrary* lib = findCoreLibrary(file);
+
+	if (lib != nullptr) { // Built into the executable, so the disk is never touched.
+		prog.source = lib->source;
+
+		if (!readCache(prog, lib->cache))
+			parseProgram(prog);
+	}
+	else if (prog.mapping.open(file)) {
+		prog.source = std::string_view(prog.mapping.data, prog.mapping.size);
+
+		if (arg.cache && loadCache(prog)) {
+			if (HPL::arg.debugAll || HPL::arg.debugLog)
+				std::cout << arg.curIndent << "LOG: [LOAD][CACHE]: " << file << ": Loaded the parsed statements from '" << getCachePath(file) << "'" << std::endl;
+		}
+		else {
+			parseProgram(prog);
+
+			if (arg.cache)
+				saveCache(prog);
+		}
+	}
+	else {
+		programs.pop_back();
+		return nullptr;
+	}
+
+	return &prog;
+}
+
+
+// Runs the includes at the top of the main file, or restores what they did from the file's snapshot.
+// Returns the amount of statements that are done.
+static size_t interpretePrelude(const HPL::program& prog) {
+	size_t prelude = 0;
+
+	while (prelude < prog.body.size() && (prog.body[prelude].type == HPL::NODE_INCLUDE || prog.body[prelude].type == HPL::NODE_READ_ONCE))
+		prelude++;
+
+	if (prelude == 0)
+		return 0;
+
+	if (HPL::loadSnapshot(prog, prelude)) {
+		HPL::curFile = prog.file;
+
+		if (HPL::arg.debugAll || HPL::arg.debugLog)
+			std::cout << HPL::arg.curIndent << "LOG: [LOAD][SNAPSHOT]: " << prog.file << ": Restored the state after the includes from '" << HPL::getSnapshotPath(prog.file) << "'" << std::endl;
+
+		return prelude;
+	}
+
+	for (size_t i = 0; i < prelude && HPL::arg.interprete; i++)
+		HPL::interpreteNode(prog.body[i]);
+
+	if (HPL::arg.interprete)
+		HPL::saveSnapshot(prog, prelude);
+
+	return prelude;
+}
+
+
 void HPL::interpreteFile(std::string file) {
+	bool isMain = modules.empty();
 	curFile = file;
-	FILE* fp = fopen(curFile.c_str(), "r");
-	bool alreadyRead = false;
 
-	for (const auto& readFile : alreadyReadFiles) {
-		if (readFile == file) {
-			alreadyRead = true;
-			break;
-		}
+	std::string path = getCanonicalPath(file);
+	module& mod = modules[path];
+	bool alreadyRead = mod.read;
+
+	if (mod.prog == nullptr)
+		mod.prog = loadProgram(file);
+
+	if (mod.prog == nullptr) { // It might get created later, so it's not remembered.
+		modules.erase(path);
+
+		std::cout << HPL::colorText("Error: ", HPL::OUTPUT_RED) << HPL::colorText(curFile, HPL::OUTPUT_RED) << ": No such file or directory" << std::endl;
+		resetRuntimeInfo();
+		return;
 	}
 
-	if (fp != NULL) {
-		fseek(fp, 0, SEEK_END);
-		long size = ftell(fp);
-		fseek(fp, 0, SEEK_SET);
+	const program& prog = *mod.prog;
+	size_t start = (isMain && arg.snapshot ? interpretePrelude(prog) : 0);
+
+	if (arg.vm) {
+		const chunk& code = compileProgram(prog);
+		runChunk(code, 0, alreadyRead, (start < code.statements.size() ? code.statements[start] : code.code.size()));
+	}
+	else {
+		for (size_t i = start; i < prog.body.size(); i++) {
+			const auto& statement = prog.body[i];
 
-		char* buf = new char[size];
-		while (fgets(buf, size + 1, fp)) {
 			if (!arg.interprete)
 				break;
 
-			buf[strcspn(buf, "\n")] = 0;
-			line = buf;
-			lineCount++;
-
-			if (find(line, "#read once") && alreadyRead)
+			if (statement.type == NODE_READ_ONCE && alreadyRead)
 				break; // Since we already read the file, just don't do it.
-			else if (find(line, "#read once"))
-				continue; // Ignore this line, otherwise an error will appear.
 
-			HPL::interpreteLine(line);
+			interpreteNode(statement);
 		}
-		if (!alreadyRead)
-			std::cout << colorText("Finished interpreting " +std::to_string(lineCount)+ " lines from ", OUTPUT_GREEN) << "'" << colorText(curFile, OUTPUT_YELLOW) << "'" << colorText(" successfully", OUTPUT_GREEN) << std::endl;
 	}
-	else
-		std::cout << HPL::colorText("Error: ", HPL::OUTPUT_RED) << HPL::colorText(curFile, HPL::OUTPUT_RED) << ": No such file or directory" << std::endl;
+	lineCount = prog.lineCount;
 
-	fclose(fp);
+	if (!alreadyRead)
+		std::cout << colorText("Finished interpreting " +std::to_string(lineCount)+ " lines from ", OUTPUT_GREEN) << "'" << colorText(curFile, OUTPUT_YELLOW) << "'" << colorText(" successfully", OUTPUT_GREEN) << std::endl;
+
+	mod.read = true;
 	resetRuntimeInfo();
-	alreadyReadFiles.push_back(file);
 }
 
 
-int HPL::interpreteLine(std::string str) {
+void HPL::interpreteBlock(const std::vector<node>& body) {
+	for (const auto& statement : body) {
+		interpreteNode(statement);
+
+		if (functionOutput.has_value() || !arg.interprete) // Returned something or the interpreter was stopped.
+			break;
+	}
+}
+
+
+int HPL::interpreteNode(const node& statement) {
 	if (!arg.interprete)
 		return FOUND_NOTHING;
 
-	if (find(str, "//")) // Ignore comments
-		str = split(str, "//", "\"\"")[0];
-
-	line = str;
+	lineCount = statement.line;
+	arena::scope temporaries(scratch); // Everything the statement allocated in the scratch arena is dropped afterwards.
 
-	if (arg.breakpoint && (mode != MODE_SAVE_FUNC && mode != MODE_SAVE_STRUCT)) { // A breakpoint was set.
+	if (arg.breakpoint) { // A breakpoint was set.
 		if (curFile == arg.breakpointValues.first && lineCount == arg.breakpointValues.second) {
 			std::cout << "Breakpoint reached at " << curFile << ":" << lineCount << std::endl;
 			arg.interprete = false;
+			return FOUND_NOTHING;
 		}
 	}
 
-	if (checkIncludes() == FOUND_SOMETHING) return FOUND_SOMETHING;
-	if (checkModes() == FOUND_SOMETHING) return FOUND_SOMETHING;
-	if (checkConditions() == FOUND_SOMETHING) return FOUND_SOMETHING;
-	if (checkFunctions() == FOUND_SOMETHING) return FOUND_SOMETHING;
-	if (checkStruct() == FOUND_SOMETHING) return FOUND_SOMETHING;
-	if (checkVariables() == FOUND_SOMETHING) return FOUND_SOMETHING;
+	switch (statement.type) {
+		case NODE_INCLUDE: return interpreteInclude(statement);
+		case NODE_READ_ONCE: return FOUND_NOTHING; // Handled by 'interpreteFile'.
+		case NODE_STRUCT: return interpreteStruct(statement);
+		case NODE_FUNCTION: return interpreteFunction(statement);
+		case NODE_IF: return interpreteCondition(statement);
+		case NODE_FOR: return interpreteLoop(statement);
+		case NODE_RETURN: return interpreteReturn(statement);
+		case NODE_DECLARATION: return interpreteDeclaration(statement, variables);
+		case NODE_ASSIGNMENT: return interpreteAssignment(statement);
+		case NODE_MATH: return interpreteMath(statement);
+		case NODE_CALL: return interpreteCall(statement);
+		case NODE_SCOPE: return interpreteScope(statement);
+	}
 
 	return FOUND_NOTHING;
 }
 
 
-int HPL::checkIncludes() {
-	if (useRegex(line, R"(#include\s+([<|\"].*[>|\"]))")) {
-		std::string match = unstringify(matches.str(1));
+int HPL::interpreteInclude(const node& statement) {
+	std::string match = statement.name;
 
-		// Save the old data, since when we're gonna interprete a new file, it's gonna overwrite the old data but not reinstate it when it's finished.
-		// Which means we have to reinstate the old data ourselves.
-		std::string oldFile = curFile;
-		int oldLineCount = lineCount;
-		lineCount = 0; // We reset it so that the lineCount won't be innaccurate when the lines gets interpreted correctly.
+	// Save the old data, since when we're gonna interprete a new file, it's gonna overwrite the old data but not reinstate it when it's finished.
+	// Which means we have to reinstate the old data ourselves.
+	std::string oldFile = curFile;
+	int oldLineCount = lineCount;
 
+	if (statement.coreInclude) // Core library '#include <libpdx.hpl>'
+		match = "core/" + match;
+	else // Some library '#include "../somelib.hpl"'
+		match = std::string(getPathFromFilename(oldFile)) + "/" + match;
 
-		if (find(line, "<") && find(line, ">")) // Core library '#include <libpdx.hpl>'
-			match = "core/" + unstringify(match, true);
-		else if (find(line, "\"")) // Some library '#include "../somelib.hpl"'
-			match = getPathFromFilename(oldFile) + "/" + match;
+	if (HPL::arg.debugAll || HPL::arg.debugLog)
+		std::cout << arg.curIndent << "LOG: [INCLUDE][FILE]: " << curFile << ":" << lineCount << ": #include <file>: #include \"" << match << "\"" << std::endl;
 
-		if (HPL::arg.debugAll || HPL::arg.debugLog)
-			std::cout << arg.curIndent << "LOG: [INCLUDE][FILE]: " << curFile << ":" << lineCount << ": #include <file>: #include \"" << match << "\"" << std::endl;
+	interpreteFile(match);
 
-		interpreteFile(match);
+	curFile = oldFile;
+	lineCount = oldLineCount;
+
+	return FOUND_SOMETHING;
+}
 
-		curFile = oldFile;
-		lineCount = oldLineCount;
 
+int HPL::interpreteStruct(const node& statement) {
+	structures.push_front({atom(statement.name)});
+	registerStruct(structures.front());
+
+	if (HPL::arg.debugAll || HPL::arg.debugLog) {
+		std::cout << arg.curIndent << "LOG: [CREATE][STRUCT]: " << curFile << ":" << lineCount << ": struct <name>: struct " << statement.name << std::endl;
+		arg.curIndent += "\t";
 	}
-	return FOUND_NOTHING;
-}
 
+	for (const auto& member : statement.body) { // Save variables inside a struct.
+		lineCount = member.line;
+		interpreteDeclaration(member, structures.front().value);
+	}
+	structures.front().defaults = structures.front().value;
+	structEpoch++; // The members changed the struct's shape.
 
-int HPL::checkModes() {
-	if ((HPL::arg.debugAll || HPL::arg.debugLog) && mode != oldMode) {
-		std::cout << arg.curIndent << colorText("LOG: [CURRENT][MODE]: ", HPL::OUTPUT_RED) << curFile << ":" << lineCount << ": <name of the mode>: " << getModeName() << std::endl;
-		oldMode = mode;
+	if (HPL::arg.debugAll || HPL::arg.debugLog) {
+		arg.curIndent.pop_back();
+		std::cout << arg.curIndent << "LOG: [DONE][STRUCT]: " << curFile << ":" << lineCount << ": struct <name> {...}: struct " << structures.front().name << " {...}" << std::endl;
 	}
 
-	if (mode == MODE_SAVE_SCOPE) {
-		variables[scopeIndex].value = xToStr(variables[scopeIndex].value) + HSM::interpreteLine(line);
+	return FOUND_SOMETHING;
+}
 
-		if (mode == MODE_DEFAULT) {
-			HPL::scopeIndex = -1;
-			HSM::equalBrackets = 1;
-			if ((HPL::arg.debugAll || HPL::arg.debugLog)) {
-				std::cout << arg.curIndent << colorText("LOG: [HSM][OFF]: ", HPL::OUTPUT_CYAN, true) << curFile << ":" << lineCount << ": HSM mode turned off, back to HPL." << std::endl;
-			}
 
-		}
+int HPL::interpreteFunction(const node& statement) {
+	function func = {statement.valueType, atom(statement.name), statement.params, &statement, statement.minParamCount, curFile, statement.line};
 
-		return FOUND_SOMETHING;
+	// Default lists and maps are made once here, as the parser only keeps their text.
+	for (auto& param : func.params) {
+		if (param.value.index() == value::STRING && (getListElement(param.type) != nullptr || getMapKey(param.type) != nullptr))
+			evaluateExpression(param, parseExpression(param.value.str()), true);
 	}
 
-	bool leftBracket = useRegex(line, R"(^\s*(\})\s*$)");
-	bool rightBracket = useRegex(line, R"(^.*\s*\{\s*$)");
+	functions.push_back(func);
 
-	if (find(line, "{") && (mode >= 0x100 && mode <= 0x1000)) {
-		switch (mode) {
-			case MODE_CHECK_STRUCT: mode = MODE_SAVE_STRUCT; break;
-			case MODE_CHECK_FUNC: mode = MODE_SAVE_FUNC; return FOUND_SOMETHING;
-			case MODE_CHECK_IF_STATEMENT: mode = MODE_SCOPE_IF_STATEMENT; return FOUND_SOMETHING; // NEEDS FIXING TOO.
-			case MODE_CHECK_IGNORE_ALL: mode = MODE_SCOPE_IGNORE_ALL; return FOUND_SOMETHING;
-			default: return FOUND_SOMETHING;
-		}
-	}
+	if (HPL::arg.debugAll || HPL::arg.debugLog)
+		std::cout << arg.curIndent << "LOG: [CREATE][FUNCTION]: " << curFile << ":" << lineCount << ": <type> <name>(<params>): " << printFunction(func) << std::endl;
 
-	if (leftBracket)
-		equalBrackets--;
-	if (rightBracket)
-		equalBrackets++;
+	return FOUND_SOMETHING;
+}
 
 
-	if (leftBracket && mode == MODE_SAVE_STRUCT) {
-		mode = MODE_DEFAULT;
+// Converts the string to a number if it's one.
+static bool toNumber(const std::string& str, double& output) {
+	if (str.empty())
+		return false;
 
-		if (HPL::arg.debugAll || HPL::arg.debugLog) {
-			arg.curIndent.pop_back();
-			std::cout << arg.curIndent << "LOG: [DONE][STRUCT]: " << curFile << ":" << lineCount << ": struct <name> {...}: struct " << structures.front().name << " {...}" << std::endl;
-		}
+	char* end;
+	output = std::strtod(str.c_str(), &end);
 
-		return FOUND_SOMETHING;
-	}
-	else if (leftBracket && mode == MODE_SAVE_FUNC && equalBrackets == 0) { // Last line, do not save anymore after this.
-		mode = MODE_DEFAULT;
+	return *end == '\0';
+}
 
-		if (HPL::arg.debugAll || HPL::arg.debugLog) {
-			arg.curIndent.pop_back();
-			std::cout << arg.curIndent << "LOG: [DONE][FUNCTION]: " << curFile << ":" << lineCount << ": <type> <name>(<params>): " << printFunction(functions.back()) << std::endl;
-		}
 
-		return FOUND_SOMETHING;
-	}
-	else if (mode == MODE_SAVE_FUNC) {
-		functions.back().code.push_back(line);
+bool HPL::compareValues(const std::string& value, const std::string& _operator, const std::string& value2) {
+	double num1, num2;
+	int cmp;
 
-		return FOUND_SOMETHING;
-	}
-	else if (mode == MODE_SCOPE_IGNORE_ALL) {
-		if (leftBracket && equalBrackets + 1 == ifStatements.back().startingLine) {
-			if (ifStatements.size() > 1)
-				mode = MODE_SCOPE_IF_STATEMENT;
-			else
-				mode = MODE_DEFAULT;
+	if (toNumber(value, num1) && toNumber(value2, num2))
+		cmp = (num1 < num2 ? -1 : (num1 > num2 ? 1 : 0));
+	else
+		cmp = value.compare(value2);
+
+	if (_operator == "==")
+		return (cmp == 0);
+	else if (_operator == "!=")
+		return (cmp != 0);
+	else if (_operator == ">=")
+		return (cmp >= 0);
+	else if (_operator == "<=")
+		return (cmp <= 0);
+	else if (_operator == ">")
+		return (cmp > 0);
+
+	return (cmp < 0);
+}
 
-			ifStatements.pop_back();
-		}
-		return FOUND_SOMETHING;
+
+int HPL::interpreteCondition(const node& statement) {
+	if (HPL::arg.debugAll || HPL::arg.debugLog) {
+		std::string condition;
+		for (const auto& v : statement.values)
+			condition += (condition.empty() ? "" : " ") + v.text;
+
+		std::cout << arg.curIndent << "LOG: [FOUND][IF-STATEMENT]: " << curFile << ":" << lineCount << ": if (<condition>): if (" << condition << ")" << std::endl;
+		arg.curIndent += "\t";
 	}
-	else if ((leftBracket || rightBracket) && mode == MODE_SCOPE_IF_STATEMENT && !ifStatements.empty()) {
-		std::vector<HPL::variable> oldVars = HPL::variables;
-		mode = MODE_DEFAULT;
-
-		if (ifStatements.back().type == "invalid") {
-			if (equalBrackets != 0)
-				mode = MODE_SCOPE_IF_STATEMENT;
-			else
-				mode = MODE_DEFAULT;
-			ifStatements.pop_back();
-
-			if (rightBracket)
-				return FOUND_NOTHING;
-			else
-				return FOUND_SOMETHING;
-		}
 
-		HPL::lineCount -= ifStatements.front().code.size();
+	// '&&' takes precedence over '||', so the condition is true if any of the
+	// groups separated by '||' only contains true values.
+	bool res = false, group = true;
 
-		for (const auto& line : ifStatements.front().code) {
-			HPL::lineCount++;
-			HPL::interpreteLine(line);
+	for (size_t i = 0; i < statement.values.size(); i++) {
+		const auto& p = statement.values[i];
+
+		if (p.text == "||") {
+			res = res || group;
+			group = true;
+			continue;
 		}
+		else if (p.text == "&&")
+			continue;
 
-		// If a global variable was edited in the function, save the changes.
-		for (const auto& newV : HPL::variables) {
-			bool found = false;
+		HPL::variable var;
+		if (!evaluateExpression(var, p, false))
+			throwError(true, "Variable '%s' doesn't exist (Cannot check the value from something that doesn't exist).", p.text.c_str());
+		std::string value = xToStr(var.value);
+		bool output;
 
-			for (auto& oldV : oldVars) {
-				if (oldV.name == newV.name) {
-					oldV.value = newV.value;
-					found = true;
-					break;
-				}
-			}
+		if (HPL::arg.debugAll || HPL::arg.debugLog)
+			std::cout << arg.curIndent << "LOG: [CHECKING][IF-STATEMENT-VALUE]: " << curFile << ":" << lineCount << ": <value> ([type]): " << value << " (" << var.type << ")" << std::endl;
 
-			if (!found && HPL::arg.dumpJson)
-				HPL::cachedVariables.push_back(newV);
-		}
-		HPL::variables = oldVars;
-		ifStatements.erase(ifStatements.begin());
-		arg.curIndent.pop_back();
+		if (i + 2 < statement.values.size() && isOperator(statement.values[i + 1], atom::RELATIONAL_OPERATOR)) {
+			const auto& _operator = statement.values[i + 1].text;
+			const auto& p2 = statement.values[i + 2];
 
-		if (!ifStatements.empty())
-			mode = MODE_SCOPE_IF_STATEMENT;
+			HPL::variable var2;
+			if (!evaluateExpression(var2, p2, false))
+				throwError(true, "Variable '%s' doesn't exist (Cannot check the value from something that doesn't exist).", p2.text.c_str());
+			std::string value2 = xToStr(var2.value);
 
-		if (leftBracket || (rightBracket && ifStatements.empty()))
-			return FOUND_SOMETHING;
-	}
-	else if (mode == MODE_SCOPE_IF_STATEMENT) {
-		if (ifStatements.empty())
-			return FOUND_SOMETHING;
+			output = compareValues(value, _operator, value2);
 
-		if (ifStatements.back().type == "invalid") {
-			return FOUND_SOMETHING;
+			if (HPL::arg.debugAll || HPL::arg.debugLog)
+				std::cout << arg.curIndent << "LOG: [OPERATOR][RELATION]: " << curFile << ":" << lineCount << ": <value 1> <operator> <value 2>: " << value << " " << _operator << " " <<  value2 << " (" << (output == true ? "true" : "false") << ")" << std::endl;
+
+			i += 2;
 		}
-		if (useRegex(line, R"(^\s*if\s*(.*)\s*\{$)")) {
-			return FOUND_NOTHING;
+		else
+			output = !(value == "false" || value == "0");
+
+		group = group && output;
+	}
+	res = res || group;
+
+	if (!res) {
+		if (HPL::arg.debugAll || HPL::arg.debugLog) {
+			arg.curIndent.pop_back();
+			std::cout << arg.curIndent << "LOG: [FAILED][IF-STATEMENT]: " << curFile << ":" << lineCount << ": Condition failed, output returned false." << std::endl;
 		}
-		ifStatements.back().code.push_back(line);
 
 		return FOUND_SOMETHING;
 	}
 
-	return FOUND_NOTHING;
-}
+	size_t start = HPL::variables.size();
 
+	interpreteBlock(statement.body);
 
-int HPL::checkConditions() {
-	if (useRegex(line, R"(^\s*if\s*(.*)\s*$)")) {
-		std::string oldValue = removeFrontAndBackSpaces(matches.str(1));
-		bool rightBracket = false;
+	HPL::variables.endBlock(start);
 
-		if (oldValue.back() == '{') {
-			rightBracket = true;
-			oldValue.pop_back();
-			mode = MODE_SCOPE_IF_STATEMENT;
-		}
-		else
-			mode = MODE_CHECK_IF_STATEMENT;
+	if (HPL::arg.debugAll || HPL::arg.debugLog)
+		arg.curIndent.pop_back();
 
-		oldValue = removeFrontAndBackSpaces(oldValue);
+	return FOUND_SOMETHING;
+}
 
 
-		auto params = split(oldValue, " ", "(){}\"\""); // NOTE: Need to a fix a bug when there's no space between an operator and two values (eg. 33=="@34")
+int HPL::interpreteLoop(const node& statement) {
+	HPL::variable items;
 
-		ifStatements.push_back({.startingLine = equalBrackets});
+	if (!evaluateExpression(items, statement.values[0], false))
+		throwError(true, "Variable '%s' doesn't exist (Cannot go through something that doesn't exist).", statement.values[0].text.c_str());
 
-		if (HPL::arg.debugAll || HPL::arg.debugLog) {
-			std::cout << arg.curIndent << "LOG: [FOUND][IF-STATEMENT]: " << curFile << ":" << lineCount << ": if (<condition>): if (" << oldValue << ")" << std::endl;
-			arg.curIndent += "\t";
-		}
+	static const HPL::list none;
+	bool isMapType = (getMapKey(items.type) != nullptr);
 
-		std::string _operator;
-		bool failed = false;
+	if (!isMapType && getListElement(items.type) == nullptr)
+		throwError(true, "Cannot go through a value that isn't a list or a map (Value '%s' is %s-typed).", statement.values[0].text.c_str(), items.type.c_str());
 
-		for (int i = 0; i < params.size(); i++) {
-			auto& p = params[i];
-			p = removeFrontAndBackSpaces(p);
+	if (HPL::arg.debugAll || HPL::arg.debugLog) {
+		std::string names = statement.names[0] + (statement.names.size() > 1 ? ", " + statement.names[1] : "");
 
-			HPL::variable var;
-			if (!setCorrectValue(var, p, false))
-				throwError(true, "Variable '%s' doesn't exist (Cannot check the value from something that doesn't exist).", p.c_str());
-			p = xToStr(var.value);
+		std::cout << arg.curIndent << "LOG: [FOUND][FOR-LOOP]: " << curFile << ":" << lineCount << ": for <names> in <list>: for " << names << " in " << statement.values[0].text << std::endl;
+		arg.curIndent += "\t";
+	}
 
-			if (HPL::arg.debugAll || HPL::arg.debugLog) {
-				std::cout << arg.curIndent << "LOG: [CHECKING][IF-STATEMENT-VALUE]: " << curFile << ":" << lineCount << ": <value> ([type]): " << p << " (" << var.type << ")" << std::endl;
-			}
+	// 'items' shares the list, so editing it inside of the body doesn't change what's gone through.
+	const HPL::list& elements = (isMap(items.value) ? getMap(items.value).values : isList(items.value) ? getList(items.value) : none);
 
-			if ((p == "false" || p == "0") && _operator.empty()) {
-				failed = true;
+	for (size_t i = 0; i < elements.size(); i++) {
+		size_t start = HPL::variables.size();
 
-				for (int x = i; x < params.size(); x++) {
-					if (params[x] == "||" || params[x] == "==" || params[x] == "!=") {
-						failed = false;
-						break;
-					}
-				}
+		if (statement.names.size() > 1) { // The index or the key comes first.
+			HPL::variable position = (isMapType ? getMap(items.value).keys.at(i) : HPL::variable{.type = HPL::atom::INT, .value = (int)i});
+			position.name = statement.names[0];
+			HPL::variables.push_back(std::move(position));
+		}
 
-				if (!failed) {
-					failed = true;
-					continue;
-				}
+		HPL::variable element = elements.at(i);
+		element.name = statement.names.back();
+		HPL::variables.push_back(std::move(element));
 
-				ifStatements.back().type = "invalid";
-				mode = rightBracket ? MODE_SCOPE_IGNORE_ALL : MODE_CHECK_IGNORE_ALL;
+		interpreteBlock(statement.body);
 
-				if (HPL::arg.debugAll || HPL::arg.debugLog) {
-					arg.curIndent.pop_back();
-					std::cout << arg.curIndent << "LOG: [FAILED][IF-STATEMENT]: " << curFile << ":" << lineCount << ": Condition failed, output returned false." << std::endl;
-				}
-				return FOUND_SOMETHING;
-			}
-			if (var.type == "relational-operator") {
-				_operator = p;
-				continue;
-			}
+		HPL::variables.endBlock(start);
 
-			if (!_operator.empty()) {
-				bool res = false;
-
-				if (_operator == "==")
-					res = (params[i - 2] == p);
-				else if (_operator == "!=")
-					res = (params[i - 2] != p);
-				else if (_operator == ">=")
-					res = (params[i - 2] >= p);
-				else if (_operator == "<=")
-					res = (params[i - 2] <= p);
-				else if (_operator == ">")
-					res = (params[i - 2] >  p);
-				else if (_operator == "<")
-					res = (params[i - 2] <  p);
-
-				if (HPL::arg.debugAll || HPL::arg.debugLog) {
-					std::cout << arg.curIndent << "LOG: [OPERATOR][RELATION]: " << curFile << ":" << lineCount << ": <value 1> <operator> <value 2>: " << params[i - 2] << " " << _operator << " " <<  p << " (" << (res == true ? "true" : "false") << ")" << std::endl;
-				}
-
-				_operator = "";
-
-				if (!res) {
-					for (int x = i; x < params.size(); x++) {
-						if (params[x] == "||") {
-							res = true;
-							break;
-						}
-					}
+		if (functionOutput.has_value() || !arg.interprete)
+			break;
+	}
 
-					if (res) {
-						failed = false;
-						continue;
-					}
+	if (HPL::arg.debugAll || HPL::arg.debugLog)
+		arg.curIndent.pop_back();
 
-					ifStatements.back().type = "invalid";
-					mode = rightBracket ? MODE_SCOPE_IGNORE_ALL : MODE_CHECK_IGNORE_ALL;
+	return FOUND_SOMETHING;
+}
 
-					if (HPL::arg.debugAll || HPL::arg.debugLog) {
-						arg.curIndent.pop_back();
-						std::cout << arg.curIndent << "LOG: [FAILED][IF-STATEMENT]: " << curFile << ":" << lineCount << ": Condition failed, output returned false." << std::endl;
-					}
 
-					return FOUND_SOMETHING;
-				}
-			}
-		}
+int HPL::interpreteReturn(const node& statement) {
+	const auto& value = statement.values[0];
 
+	if (value.type == EXPRESSION_EMPTY)
 		return FOUND_SOMETHING;
-	}
 
-	return FOUND_NOTHING;
+	evaluateExpression(functionOutput, value, false);
+
+	if (HPL::arg.debugAll || HPL::arg.debugLog)
+		std::cout << arg.curIndent << "LOG: [FOUND][RETURN]: " << curFile << ":" << lineCount << ": return <value> (<type>): return " << xToStr(functionOutput.value) << " (" << functionOutput.type << ")" << std::endl;
+
+	return FOUND_SOMETHING;
 }
 
 
-int HPL::checkStruct() {
-	// 'struct <name> {' Only matches the <name>
-	if (useRegex(line, R"(struct\s+([a-zA-Z]+))")) {
-		std::string name = removeSpaces(matches.str(1));
+// Declares the variables inside of the output, which is either a struct's members or 'HPL::variables'.
+template<typename T>
+static int declareVariables(const HPL::node& statement, T& output) {
+	static const HPL::expression noValue;
 
-		structures.insert(structures.begin(), {name});
-		mode = MODE_CHECK_STRUCT;
+	for (size_t listOfVarIndex = 0; listOfVarIndex < statement.names.size(); listOfVarIndex++) {
+		HPL::variable var = {.type = statement.valueType, .name = statement.names[listOfVarIndex]};
+		HPL::structure* s = nullptr;
+		const HPL::expression& value = (listOfVarIndex < statement.values.size() ? statement.values[listOfVarIndex] : noValue);
 
-		if (HPL::arg.debugAll || HPL::arg.debugLog) {
-			std::cout << arg.curIndent << "LOG: [CREATE][STRUCT]: " << curFile << ":" << lineCount << ": struct <name>: struct " << name << std::endl;
-			arg.curIndent += "\t";
-		}
+		if (!typeIsValid(var.type, s)) // Type isn't cored or a structure.
+			HPL::throwError(true, "Type '%s' doesn't exist (Cannot init a variable without valid type).", var.type.c_str());
 
-		if (find(line, "{")) {
-			mode = MODE_SAVE_STRUCT;
-			return FOUND_SOMETHING;
-		}
+		if (!evaluateExpression(var, value, true) && value.type != HPL::EXPRESSION_EMPTY)
+			HPL::throwError(true, "Variable '%s' doesn't exist (Cannot copy value from something that doesn't exist).", value.text.c_str());
+
+		output.push_back(var);
+
+		if (HPL::arg.debugAll || HPL::arg.debugLog)
+			std::cout << HPL::arg.curIndent << "LOG: [CREATE][VARIABLE]: " << HPL::curFile << ":" << HPL::lineCount << ": <type> <variable> = [value]: " << printVar(var) << std::endl;
 	}
 
-	return FOUND_NOTHING;
+	return FOUND_SOMETHING;
 }
 
 
+int HPL::interpreteDeclaration(const node& statement, std::vector<variable>& output) {
+	return declareVariables(statement, output);
+}
 
-int HPL::checkFunctions() {
-	// Match <return type> <name>(<params>) {
-	if (useRegex(line, R"(^\s*([^\s]+)\s+([^\s]+)\s*\((.*)\)\s*\{?$)") && matches.size() >= 3) {
-		function func = {matches.str(1), matches.str(2)};
-		std::vector<std::string> params = split(matches.str(3), ",", "(){}\"\"");
 
-		for (const auto& v : params) {
-			if (useRegex(v, R"(\s*([^\s]+)\s+([^\s]+)?\s*=?\s*(f?\".*\"|\{.*\}|[^\s*]*)\s*)")) {
-				variable var = {matches.str(1), matches.str(2)};
+int HPL::interpreteDeclaration(const node& statement, variableTable& output) {
+	return declareVariables(statement, output);
+}
 
-				if (matches.str(3).empty())
-					func.minParamCount++;
-				else
-					var.value = unstringify(matches.str(3));
 
-				func.params.push_back(var);
-			}
-		}
-		func.file = HPL::curFile;
-		func.startingLine = HPL::lineCount;
+int HPL::interpreteAssignment(const node& statement) {
+	listElement element;
+	HPL::variable* existingVar = (statement.values.size() > 1 ? findElement(statement.values[1], element, true) : getVarFromName(statement.name, true));
 
-		functions.push_back(func);
-		mode = MODE_CHECK_FUNC;
+	if (existingVar == nullptr)
+		HPL::throwError(true, "Variable '%s' doesn't exist (Can't edit a variable that doesn't exist)", statement.name.c_str());
 
-		if (HPL::arg.debugAll || HPL::arg.debugLog) {
-			std::cout << arg.curIndent << "LOG: [CREATE][FUNCTION]: " << curFile << ":" << lineCount << ": <type> <name>(<params>): " << printFunction(func) << std::endl;
-			arg.curIndent += "\t";
-		}
+	// The value is evaluated into a copy, as a call inside of it might move the variables. Elements
+	// are copies already, while variables are found again afterwards.
+	HPL::variable var = *existingVar;
+	evaluateExpression(var, statement.values[0], true);
 
-		if (find(line, "{"))
-			mode = MODE_SAVE_FUNC;
+	if (element.source == nullptr)
+		existingVar = getVarFromName(statement.name, true);
 
-		return FOUND_SOMETHING;
-	}
-	else if (useRegex(line, R"(^\s*([^\s\(]+)\((.*)\)\s*$)") && matches.size() == 2) {
-		function f; HPL::variable res;
+	existingVar->value = std::move(var.value);
 
-		if (HPL::arg.debugAll || HPL::arg.debugLog)
-			std::cout << arg.curIndent << "LOG: [USE][FUNCTION]: " << curFile << ":" << lineCount << ": <name>(<params>): " << matches.str(1) << "(" << matches.str(2) << ")" << std::endl;
+	if (element.source != nullptr)
+		storeElement(element);
 
-		return executeFunction(matches.str(1), matches.str(2), f, res);
-	}
-	else if (useRegex(line, R"(^\s*return\s+(f?\".*\"|\{.*\}|[^\s]+\(.*\)|[^\s]*)\s*$)")) {
-		setCorrectValue(functionOutput, matches.str(1), false);
+	if (HPL::arg.debugAll || HPL::arg.debugLog)
+		std::cout << arg.curIndent << "LOG: [EDIT][VARIABLE]: " << curFile << ":" << lineCount << ": <type> <variable> = <value>: " << printVar(*existingVar) << std::endl;
 
-		if (HPL::arg.debugAll || HPL::arg.debugLog)
-			std::cout << arg.curIndent << "LOG: [FOUND][RETURN]: " << curFile << ":" << lineCount << ": return <value> (<type>): return " << xToStr(functionOutput.value) << " (" << functionOutput.type << ")" << std::endl;
+	return FOUND_SOMETHING;
+}
 
-		return FOUND_SOMETHING;
-	}
 
-	return FOUND_NOTHING;
-}
+int HPL::interpreteMath(const node& statement) {
+	listElement element;
+	variable* existingVar = (statement.values.size() > 1 ? findElement(statement.values[1], element, true) : getVarFromName(statement.name, true));
+	const expression& value = statement.values[0];
 
+	if (existingVar == nullptr)
+		throwError(true, "Cannot perform any math operations to this variable (Variable '%s' does not exist).", statement.name.c_str());
 
-int HPL::checkVariables() {
-	// <name> = <value>
-	if (useRegex(line, R"(^\s*([^\s]+)\s*[^\-\+\/\*]=\s*(f?\".*\"|\{.*\}|\w*\(.*\)|[\d\s\+\-\*\/\.]+[^\w]*|[^\s]*)\s*.*$)")) { // Edit a pre-existing variable
-		variable info = {"", matches.str(1), matches.str(2)};
-		auto& value = getStr(info.value);
+	if (value.type == EXPRESSION_EMPTY)
+		doMath(*existingVar, statement._operator, nullptr);
+	else {
+		HPL::variable var;
+		bool found = evaluateExpression(var, value, false);
 
-		HPL::variable* existingVar = getVarFromName(info.name);
+		// A call inside of the value might've moved the variables, so the variable is found again.
+		if (element.source == nullptr)
+			existingVar = getVarFromName(statement.name, true);
 
-		if (existingVar == nullptr)
-			HPL::throwError(true, "Variable '%s' doesn't exist (Can't edit a variable that doesn't exist)", info.name.c_str());
+		if (!found && existingVar->type != HPL::atom::STRING)
+			throwError(true, "Variable '%s' doesn't exist (Cannot perform math with something that doesn't exist).", value.text.c_str());
 
-		setCorrectValue(*existingVar, value, true);
+		doMath(*existingVar, statement._operator, &var);
+	}
 
-		if (HPL::arg.debugAll || HPL::arg.debugLog)
-			std::cout << arg.curIndent << "LOG: [EDIT][VARIABLE]: " << curFile << ":" << lineCount << ": <type> <variable> = <value>: " << printVar(*existingVar) << std::endl;
+	if (element.source != nullptr)
+		storeElement(element);
+
+	if (HPL::arg.debugAll || HPL::arg.debugLog) {
+		std::cout << arg.curIndent << "LOG: [MATH][VARIABLE]: " << curFile << ":" << lineCount << ": <variable> <operator> [value]: " << existingVar->name << " " << statement._operator;
+		if (value.type != EXPRESSION_EMPTY)
+			std::cout << " " << value.text;
+		std::cout << std::endl;
 	}
-	//<int/float/string> <operator> [value]
-	else if (useRegex(line, R"(^\s*([^\s\-\+]+)\s*([\+\-\*\/\=]+)\s*(f?\".*\"|\{.*\}|[^\s]+\(.*\)|[^\s]*)\s*.*$)")) { // A math operator.
-		variable* existingVar = getVarFromName(matches.str(1));
-		std::string value = matches.str(3);
-		float res;
 
-		if (existingVar == nullptr)
-			throwError(true, "Cannot perform any math operations to this variable (Variable '%s' does not exist).", matches.str(1).c_str());
+	return FOUND_SOMETHING;
+}
+
 
-		if (!(existingVar->type == "int" || existingVar->type == "float" || existingVar->type == "string"))
-			HPL::throwError(true, "Cannot perform any math operations to a non-int variable (Variable '%s' isn't int/float/string-typed, can't operate to a '%s' type).", existingVar->name.c_str(), existingVar->type.c_str());
+void HPL::doMath(variable& var, const std::string& _operator, const variable* value) {
+	float res = 0;
 
-		if (existingVar->type == "string" && matches.str(2) == "+=") {
-			HPL::variable var;
-			setCorrectValue(var, value, false);
+	if (const typeInfo* element = getListElement(var.type)) {
+		if (_operator != "+=")
+			HPL::throwError(true, "Cannot perform a '%s' operation on a list (Only '+=' is allowed for lists, which appends the value).", _operator.c_str());
 
-			if (var.type == "struct" || var.type == "scope")
-				HPL::throwError(true, "Cannot append a %s type to a string (Value '%s' is a %s-type).", var.type.c_str(), xToStr(var.value).c_str(), var.type.c_str());
+		if (value == nullptr)
+			return;
 
+		if (!isList(var.value))
+			var.value = list(element->name);
 
-			existingVar->value = xToStr(existingVar->value) + xToStr(var.value);
+		if (value->type == var.type) { // Appends every element of the other list.
+			list other = getList(value->value); // 'var' might be the same list.
+			list& items = var.value.items();
 
-			return FOUND_SOMETHING;
-		}
+			for (size_t i = 0; i < other.size(); i++)
+				items.push_back(other.at(i));
 
-		else {
-			float dec1, dec2;
-
-			if (existingVar->type == "int")
-				dec1 = xToType<int>(existingVar->value);
-			else
-				dec1 = xToType<float>(existingVar->value);
-
-
-			if (!value.empty())
-				dec2 = std::stof(value);
-
-
-			if (matches.str(2) == "++")
-				res = dec1 + 1;
-			else if (matches.str(2) == "--")
-				res = dec1 - 1;
-			else if (matches.str(2) == "+=")
-				res = dec1 + dec2;
-			else if (matches.str(2) == "-=")
-				res = dec1 - dec2;
-			else if (matches.str(2) == "*=")
-				res = dec1 * dec2;
-			else if (matches.str(2) == "/=")
-				res = dec1 / dec2;
-			else if (matches.str(2) == "%=")
-				res = fmod(dec1, dec2);
-
-			if (existingVar->type == "int")
-				existingVar->value = (int)res;
-			else if (existingVar->type == "float")
-				existingVar->value = (float)res;
+			return;
 		}
 
-		if (HPL::arg.debugAll || HPL::arg.debugLog) {
-			std::cout << arg.curIndent << "LOG: [MATH][VARIABLE]: " << curFile << ":" << lineCount << ": <variable> <operator> [value]: " << existingVar->name << " " << matches.str(2);
-			if (matches.str(2) != "--" || matches.str(2) != "++")
-				std::cout << " " << matches.str(3);
-			std::cout << std::endl;
+		variable item = *value;
+
+		if (item.type != element->name) {
+			if ((element->name == HPL::atom::INT || element->name == HPL::atom::FLOAT) && (item.type == HPL::atom::INT || item.type == HPL::atom::FLOAT)) {
+				item.type = element->name;
+				item.value = (element->name == HPL::atom::INT ? allowedTypes(xToType<int>(value->value)) : allowedTypes(xToType<float>(value->value)));
+			}
+			else if (!(element->_struct != nullptr && item.type == HPL::atom::STRUCT))
+				HPL::throwError(true, "Cannot append a %s type to a list of %s (Value '%s' is a %s-type).", item.type.c_str(), element->name.c_str(), xToStr(value->value).c_str(), item.type.c_str());
 		}
+
+		var.value.items().push_back(item);
+		return;
 	}
-	// Matches the type, name and value
-	else if (useRegex(line, R"(^\s*([^\s]+)\s+(\b[^=]+\b)\s*=?\s*(f?\".*\"|\{.*\}|[^\s]+\(.*\)|.*)\s*$)")) { // Declaring (a) new variable(s).
-		auto listOfVarNames = split(matches.str(2), ",");
-		auto listOfVarValues = split(matches.str(3), ",", "(){}\"\"");
-		std::string ogType = matches.str(1);
 
+	if (!(var.type == HPL::atom::INT || var.type == HPL::atom::FLOAT || var.type == HPL::atom::STRING))
+		HPL::throwError(true, "Cannot perform any math operations to a non-int variable (Variable '%s' isn't int/float/string-typed, can't operate to a '%s' type).", var.name.c_str(), var.type.c_str());
 
-		for (int listOfVarIndex = 0; listOfVarIndex < listOfVarNames.size(); listOfVarIndex++) {
-			variable var = {.type = ogType, .name = removeSpaces(listOfVarNames[listOfVarIndex]), .value = std::string{}};
-			structure* s;
+	if (var.type == HPL::atom::STRING) {
+		if (_operator != "+=")
+			HPL::throwError(true, "Cannot perform a '%s' operation on a string (Only '+=' is allowed for strings).", _operator.c_str());
 
-			if (listOfVarIndex < listOfVarValues.size())
-				var.value = removeFrontAndBackSpaces(listOfVarValues[listOfVarIndex]);
+		if (value == nullptr)
+			return;
 
-			auto& value = getStr(var.value);
+		if (value->type == HPL::atom::STRUCT || value->type == HPL::atom::SCOPE)
+			HPL::throwError(true, "Cannot append a %s type to a string (Value '%s' is a %s-type).", value->type.c_str(), xToStr(value->value).c_str(), value->type.c_str());
 
-			if (value.empty())
-				var.reset_value();
+		if (var.value.index() != HPL::value::STRING && var.value.index() != HPL::value::NOTHING)
+			var.value = xToStr(var.value);
 
-			if (!typeIsValid(var.type, s)) // Type isn't cored or a structure.
-				throwError(true, "Type '%s' doesn't exist (Cannot init a variable without valid type).", var.type.c_str());
+		var.value.append(xToStr(value->value)); // Grows the string in place instead of copying it on every append.
+		return;
+	}
 
-			if (!setCorrectValue(var, value, true) && !value.empty())
-				throwError(true, "Variable '%s' doesn't exist (Cannot copy value from something that doesn't exist).", value.c_str());
+	float dec1, dec2 = 0;
 
-			auto pointerToOutput = &variables;
+	if (var.type == HPL::atom::INT)
+		dec1 = xToType<int>(var.value);
+	else
+		dec1 = xToType<float>(var.value);
+
+	if (value != nullptr)
+		dec2 = xToType<float>(value->value);
+
+	if (_operator == "++")
+		res = dec1 + 1;
+	else if (_operator == "--")
+		res = dec1 - 1;
+	else if (_operator == "+=")
+		res = dec1 + dec2;
+	else if (_operator == "-=")
+		res = dec1 - dec2;
+	else if (_operator == "*=")
+		res = dec1 * dec2;
+	else if (_operator == "/=")
+		res = dec1 / dec2;
+	else if (_operator == "%=")
+		res = fmod(dec1, dec2);
+
+	if (var.type == HPL::atom::INT)
+		var.value = (int)res;
+	else if (var.type == HPL::atom::FLOAT)
+		var.value = (float)res;
+}
 
 
-			if (mode == MODE_SAVE_STRUCT) // Save variables inside a struct.
-				pointerToOutput = &structures.begin()->value;
+int HPL::interpreteCall(const node& statement) {
+	function f; HPL::variable res;
 
-			pointerToOutput->push_back(var);
+	if (HPL::arg.debugAll || HPL::arg.debugLog)
+		std::cout << arg.curIndent << "LOG: [USE][FUNCTION]: " << curFile << ":" << lineCount << ": <name>(<params>): " << statement.values[0].text << std::endl;
 
-			if (var.type == "scope")
-				scopeIndex = pointerToOutput->size() - 1;
+	return executeFunction(statement.name, statement.values[0].args, f, res);
+}
 
-			if (HPL::arg.debugAll || HPL::arg.debugLog)
-				std::cout << arg.curIndent << "LOG: [CREATE][VARIABLE]: " << curFile << ":" << lineCount << ": <type> <variable> = [value]: " << printVar(var) << std::endl;
-		}
-		return FOUND_SOMETHING;
+
+int HPL::interpreteScope(const node& statement) {
+	variable var = {atom::SCOPE, atom(statement.name)};
+	variables.push_back(var);
+	size_t scopeIndex = variables.size() - 1;
+
+	HSM::equalBrackets = 1;
+	variables[0].value = true; // Scope mode is ON!
+
+	if (HPL::arg.debugAll || HPL::arg.debugLog)
+		std::cout << arg.curIndent << "LOG: [CREATE][VARIABLE]: " << curFile << ":" << lineCount << ": <type> <variable> = [value]: " << printVar(var) << std::endl;
+
+	for (size_t i = 0; i < statement.lines.size(); i++) {
+		lineCount = statement.line + i + 1;
+		std::string line = HSM::interpreteLine(statement.lines[i]); // Might add variables, so the scope is found after it.
+		variables[scopeIndex].value.append(line);
+
+		if (!arg.interprete)
+			return FOUND_NOTHING;
 	}
 
+	auto& value = variables[scopeIndex].value.string();
+	if (!value.empty() && value.back() == '\n')
+		value.pop_back();
 
-	return FOUND_NOTHING;
+	variables[0].value = false;
+
+	if (HPL::arg.debugAll || HPL::arg.debugLog)
+		std::cout << arg.curIndent << colorText("LOG: [HSM][OFF]: ", HPL::OUTPUT_CYAN, true) << curFile << ":" << lineCount << ": HSM mode turned off, back to HPL." << std::endl;
+
+	return FOUND_SOMETHING;
 }
 
 
@@ -664,7 +745,7 @@ void HPL::debugMode() {
 	std::cout << colorText("============ DEBUG INFORMATION ============\n", HPL::OUTPUT_PURPLE);
 
 	std::cout << colorText("Variables:\n", OUTPUT_CYAN, true);
-	debugPrintVar(variables);
+	debugPrintVar(variables.values);
 	std::cout << colorText("\nStructures:\n", OUTPUT_CYAN, true);
 	debugPrintStruct(structures);
 	std::cout << colorText("Functions:\n", OUTPUT_CYAN, true);
@@ -673,7 +754,7 @@ void HPL::debugMode() {
 
 
 void HPL::debugPrintVar(std::vector<variable> vars, std::string tabs/* = "	"*/, std::string end/* = "\n"*/) {
-	for (int index = 0; index < vars.size(); index++) {  // Regular variables
+	for (size_t index = 0; index < vars.size(); index++) {  // Regular variables
 		auto& var = vars[index];
 
 		RETURN_OUTPUT clr = OUTPUT_PURPLE;
@@ -690,8 +771,8 @@ void HPL::debugPrintVar(std::vector<variable> vars, std::string tabs/* = "	"*/,
 }
 
 
-void HPL::debugPrintStruct(std::vector<structure> structList, std::string indent/* = "\t"*/) {
-	for (const auto& s : structures) {
+void HPL::debugPrintStruct(const std::deque<structure>& structList, std::string indent/* = "\t"*/) {
+	for (const auto& s : structList) {
 		std::cout << indent << colorText("struct", HPL::OUTPUT_PURPLE) << " " << colorText(s.name, HPL::OUTPUT_YELLOW) << colorText(" {", HPL::OUTPUT_GREEN) << std::endl;
 		debugPrintVar(s.value, indent + indent);
 		std::cout << colorText("\n" + indent + "}\n", HPL::OUTPUT_GREEN);
@@ -703,15 +784,17 @@ void HPL::debugPrintFunc(std::vector<function> func, std::string indent/* = "\t"
 	for (const auto& f : functions) {
 		RETURN_OUTPUT clr = OUTPUT_PURPLE;
 
-		if (f.type == "scope")
+		if (f.type == HPL::atom::SCOPE)
 			clr = OUTPUT_BLUE;
 		else if (!coreTyped(f.type))
 			clr = OUTPUT_RED;
 
 		std::cout << indent << colorText(f.type, clr) << " " << f.name << "("; debugPrintVar(f.params, "", ", "); std::cout << ") {\n";
 
-		for (auto c : f.code)
-			std::cout << indent << c << std::endl;
+		parseFunctionBody(*f.definition, f.file);
+
+		for (const auto& statement : f.definition->body)
+			std::cout << indent << indent << statement.text << std::endl;
 
 		std::cout << indent << "}" << std::endl;
 	}
@@ -720,11 +803,9 @@ void HPL::debugPrintFunc(std::vector<function> func, std::string indent/* = "\t"
 
 void HPL::resetRuntimeInfo() {
 	curFile.clear();
-	line.clear();
 	functionOutput.reset_value();
 
 	lineCount = 0;
-	mode = MODE_DEFAULT;
 	matches = {};
 }
 
@@ -741,7 +822,7 @@ void HPL::throwError(bool sendRuntimeError, std::string text, ...) {
 	std::string msg = colorText("Error at ", OUTPUT_RED) + "'" + colorText(curFile + ":" + std::to_string(lineCount), OUTPUT_YELLOW) + "'" + colorText(": ", OUTPUT_RED);
 	#endif
 
-	for (int i = 0; i < text.size(); i++) {
+	for (size_t i = 0; i < text.size(); i++) {
 		auto x = text[i];
 		int num = 0;
 		colorMode = false;
@@ -832,24 +913,139 @@ void HPL::throwError(bool sendRuntimeError, std::string text, ...) {
 }
 
 
-std::string HPL::getModeName() {
-	switch (mode) {
-		case MODE_DEFAULT: return "MODE_DEFAULT";
+HPL::variable* HPL::variableTable::find(atom name) {
+	if (name.index() >= indexes.size() || indexes[name.index()].empty())
+		return nullptr;
+
+	return &values[indexes[name.index()].front()];
+}
+
+
+bool HPL::variableTable::existsBefore(atom name, size_t end) const {
+	return name.index() < indexes.size() && !indexes[name.index()].empty() && indexes[name.index()].front() < end;
+}
+
+
+void HPL::variableTable::push_back(variable var) {
+	if (var.name.index() >= indexes.size())
+		indexes.resize(var.name.index() + 1);
+
+	indexes[var.name.index()].push_back(values.size());
+	values.push_back(std::move(var));
+}
+
+
+void HPL::variableTable::resize(size_t size) {
+	while (values.size() > size) {
+		indexes[values.back().name.index()].pop_back();
+		values.pop_back();
+	}
+}
+
+
+void HPL::variableTable::endBlock(size_t start) {
+	for (size_t i = start; i < values.size(); i++) {
+		size_t oldest = indexes[values[i].name.index()].front();
+
+		if (oldest < start)
+			values[oldest].value = values[i].value;
+		else if (HPL::arg.dumpJson)
+			HPL::cachedVariables.push_back(values[i]);
+	}
+
+	resize(start);
+}
+
+
+void HPL::variableTable::assign(std::vector<variable> vars) {
+	values.clear();
+	indexes.clear();
+
+	for (auto& var : vars)
+		push_back(std::move(var));
+}
+
+
+// Every type that was found, by its ID, and the type IDs found by the name's atom (-1 if there's none). The
+// core types are always registered first, so that they're found even if no struct was defined yet.
+struct typeRegistry {
+	std::deque<HPL::typeInfo> types;
+	std::vector<int> ids;
+
+	typeRegistry() {
+		for (const auto& type : coreTypes)
+			add(type).core = true;
+	}
+
+	HPL::typeInfo& add(HPL::atom name) {
+		if (name.index() >= ids.size())
+			ids.resize(name.index() + 1, -1);
+
+		if (ids[name.index()] == -1) {
+			ids[name.index()] = types.size();
+			types.push_back({(int)types.size(), name});
+		}
+
+		return types[ids[name.index()]];
+	}
+};
+
+
+static typeRegistry& getTypes() {
+	static typeRegistry registry;
+	return registry;
+}
+
+
+const HPL::typeInfo* HPL::findType(atom name) {
+	typeRegistry& registry = getTypes();
+
+	if (name.index() < registry.ids.size() && registry.ids[name.index()] != -1)
+		return &registry.types[registry.ids[name.index()]];
+
+	// Lists (eg. 'int[]') and maps (eg. 'int[string]') get registered once they're first used, as
+	// long as the type of their elements exists. The keys of a map can only be of a core type.
+	const std::string& text = name.str();
+	size_t open = text.rfind('[');
+
+	if (open == std::string::npos || open == 0 || text.back() != ']')
+		return nullptr;
 
-		case MODE_SAVE_STRUCT: return "MODE_SAVE_STRUCT";
-		case MODE_SAVE_FUNC: return "MODE_SAVE_FUNC";
-		case MODE_SAVE_SCOPE: return "MODE_SAVE_SCOPE";
-		case MODE_SCOPE_IF_STATEMENT: return "MODE_SCOPE_IF_STATEMENT";
-		case MODE_SCOPE_IGNORE_ALL: return "MODE_SCOPE_IGNORE_ALL";
+	const typeInfo* element = findType(atom(text.substr(0, open)));
+	const typeInfo* key = nullptr;
 
+	if (open + 2 < text.size()) {
+		key = findType(atom(text.substr(open + 1, text.size() - open - 2)));
 
-		case MODE_CHECK_STRUCT: return "MODE_CHECK_STRUCT";
-		case MODE_CHECK_FUNC: return "MODE_CHECK_FUNC";
-		case MODE_CHECK_SCOPE: return "MODE_CHECK_SCOPE";
-		case MODE_CHECK_IF_STATEMENT: return "MODE_CHECK_IF_STATEMENT";
-		case MODE_CHECK_IGNORE_ALL: return "MODE_CHECK_IGNORE_ALL";
-		default: return "N/A";
+		if (key == nullptr || !key->core || key->name == HPL::atom::SCOPE)
+			return nullptr;
 	}
+
+	if (element == nullptr)
+		return nullptr;
+
+	typeInfo& container = registry.add(name);
+	container.element = element;
+	container.key = key;
+
+	return &container;
+}
+
+
+void HPL::registerStruct(structure& s) {
+	getTypes().add(s.name)._struct = &s;
+	structEpoch++;
+}
+
+
+void HPL::registerStructs() {
+	for (auto& type : getTypes().types)
+		type._struct = nullptr;
+	structEpoch++;
+
+	// The oldest struct is last, so the newest ones replace it.
+	for (auto it = structures.rbegin(); it != structures.rend(); it++)
+		registerStruct(*it);
 }
 
 
@@ -859,21 +1055,18 @@ namespace HPL {
 
 	// Interpreter rules runtime.
 	std::string curFile;
-	std::string line;
 	int lineCount = 0;
-	int mode = 0;
 	HPL::vector matches;
-	int equalBrackets = 0;
-	int scopeIndex = -1;
-	int oldMode = -1;
 
 	// Defnitions that are saved in memory.
-	std::vector<variable> variables = {{"bool", "HPL_SCOPE_MODE", false}};
-	std::vector<structure> structures;
+	variableTable variables(std::vector<variable>{{atom::BOOL, atom("HPL_SCOPE_MODE"), false}});
+	std::deque<structure> structures;
+	unsigned structEpoch = 0;
 	std::vector<function> functions;
-	std::vector<function> ifStatements;
 
 	std::vector<variable> cachedVariables;
 
 	HPL::variable functionOutput;
+
+	std::unordered_map<std::string, module> modules;
 }
\ No newline at end of file
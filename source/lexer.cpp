@@ -0,0 +1,182 @@
+/*
+* Copyright (C) 2022-2023 EimaMei/Sacode
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+*    claim that you wrote the original software. If you use this software
+*    in a product, an acknowledgment in the product documentation would be
+*    appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+*    misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*
+*
+*/
+
+#include <lexer.hpp>
+#include <interpreter.hpp>
+
+#include <cctype>
+
+
+// Operators that are longer than one character. The order matters, as the
+// first match wins.
+static const char* longOperators[] = { "++", "--", "+=", "-=", "*=", "/=", "%=", "==", "!=", ">=", "<=", "&&", "||" };
+
+
+static bool isIdentifierStart(char c) { return std::isalpha((unsigned char)c) || c == '_'; }
+static bool isIdentifierChar(char c) { return std::isalnum((unsigned char)c) || c == '_'; }
+
+
+HPL::token HPL::lexer::next() {
+	// Skip the whitespace and comments.
+	while (pos < source.size()) {
+		char c = source[pos];
+
+		if (c == ' ' || c == '\t' || c == '\r')
+			pos++;
+		else if (c == '/' && pos + 1 < source.size() && source[pos + 1] == '/') {
+			while (pos < source.size() && source[pos] != '\n')
+				pos++;
+		}
+		else
+			break;
+	}
+
+	token tok = {TOKEN_EOF, {}, line, pos, pos};
+
+	if (pos >= source.size())
+		return tok;
+
+	char c = source[pos];
+
+	if (c == '\n') {
+		tok.type = TOKEN_NEWLINE;
+		pos++;
+		line++;
+	}
+	else if (c == '#') { // The entire line is the directive.
+		tok.type = TOKEN_DIRECTIVE;
+		pos++;
+
+		while (pos < source.size() && source[pos] != '\n' && source[pos] != '\r')
+			pos++;
+
+		tok.begin++;
+	}
+	else if (c == '"' || (c == 'f' && pos + 1 < source.size() && source[pos + 1] == '"')) {
+		tok.type = (c == 'f' ? TOKEN_FSTRING : TOKEN_STRING);
+		pos += (c == 'f' ? 2 : 1);
+
+		while (pos < source.size() && source[pos] != '"') {
+			if (source[pos] == '\\') {
+				pos++;
+
+				if (pos < source.size() && source[pos] == '\n') // An escaped new line still starts a new line.
+					line++;
+			}
+			else if (source[pos] == '\n') {
+				lineCount = line;
+				throwError(true, "Missing terminating '\"' character.");
+			}
+			pos++;
+		}
+
+		if (pos >= source.size()) {
+			lineCount = line;
+			throwError(true, "Missing terminating '\"' character.");
+		}
+		pos++;
+	}
+	else if (isIdentifierStart(c)) {
+		tok.type = TOKEN_IDENTIFIER;
+
+		while (pos < source.size() && isIdentifierChar(source[pos]))
+			pos++;
+	}
+	else if (std::isdigit((unsigned char)c)) {
+		tok.type = TOKEN_NUMBER;
+
+		while (pos < source.size() && (std::isdigit((unsigned char)source[pos]) || source[pos] == '.'))
+			pos++;
+	}
+	else {
+		tok.type = TOKEN_OPERATOR;
+		pos++;
+
+		for (const char* op : longOperators) {
+			if (source.substr(tok.begin, 2) == op) {
+				pos = tok.begin + 2;
+				break;
+			}
+		}
+	}
+
+	tok.end = pos;
+	tok.text = source.substr(tok.begin, tok.end - tok.begin);
+
+	return tok;
+}
+
+
+std::vector<std::string_view> HPL::lexer::readRawBlock(int& firstLine) {
+	std::vector<std::string_view> lines;
+	int depth = 1;
+
+	// Whatever is left after the '{' is ignored.
+	while (pos < source.size() && source[pos] != '\n')
+		pos++;
+
+	if (pos < source.size()) {
+		pos++;
+		line++;
+	}
+	firstLine = line;
+
+	while (pos < source.size()) {
+		size_t end = source.find('\n', pos);
+		if (end == std::string_view::npos)
+			end = source.size();
+
+		std::string_view str = source.substr(pos, end - pos);
+		bool inString = false;
+
+		for (size_t i = 0; i < str.size(); i++) {
+			char c = str[i];
+
+			if (c == '\\' && inString)
+				i++;
+			else if (c == '"')
+				inString = !inString;
+			else if (c == '#' && !inString)
+				break;
+			else if (c == '{' && !inString)
+				depth++;
+			else if (c == '}' && !inString)
+				depth--;
+		}
+
+		pos = (end < source.size() ? end + 1 : end);
+		line++;
+
+		if (depth <= 0)
+			return lines;
+
+		if (!str.empty() && str.back() == '\r')
+			str.remove_suffix(1);
+
+		lines.push_back(str);
+	}
+
+	lineCount = firstLine;
+	throwError(true, "Missing a closing '}' for the scope.");
+
+	return lines;
+}
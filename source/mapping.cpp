@@ -0,0 +1,98 @@
+/*
+* Copyright (C) 2022-2023 EimaMei/Sacode
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+*    claim that you wrote the original software. If you use this software
+*    in a product, an acknowledgment in the product documentation would be
+*    appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+*    misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*
+*
+*/
+
+#include <parser.hpp>
+
+#if defined(WINDOWS)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+bool HPL::mappedFile::open(const std::string& path) {
+	close();
+
+	#if defined(WINDOWS)
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	GetFileSizeEx(file, &fileSize);
+	size = fileSize.QuadPart;
+
+	if (size != 0) {
+		HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		data = (mapping != NULL ? (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr);
+
+		if (mapping != NULL)
+			CloseHandle(mapping); // The view keeps the mapping alive.
+	}
+	CloseHandle(file);
+
+	#else
+	int file = ::open(path.c_str(), O_RDONLY);
+	if (file == -1)
+		return false;
+
+	struct stat info;
+	if (fstat(file, &info) == -1 || S_ISDIR(info.st_mode)) {
+		::close(file);
+		return false;
+	}
+	size = info.st_size;
+
+	if (size != 0) {
+		void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+		data = (view != MAP_FAILED ? (const char*)view : nullptr);
+	}
+	::close(file); // The mapping stays after the file is closed.
+	#endif
+
+	if (size != 0 && data == nullptr) {
+		size = 0;
+		return false;
+	}
+
+	if (size == 0) // Empty files can't be mapped.
+		data = "";
+
+	return true;
+}
+
+
+void HPL::mappedFile::close() {
+	if (size != 0) {
+		#if defined(WINDOWS)
+		UnmapViewOfFile(data);
+		#else
+		munmap((void*)data, size);
+		#endif
+	}
+
+	data = nullptr;
+	size = 0;
+}
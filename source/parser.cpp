@@ -0,0 +1,798 @@
+/*
+* Copyright (C) 2022-2023 EimaMei/Sacode
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+*    claim that you wrote the original software. If you use this software
+*    in a product, an acknowledgment in the product documentation would be
+*    appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+*    misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*
+*
+*/
+
+#include <parser.hpp>
+#include <helper.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <deque>
+
+
+struct parser {
+	HPL::program& prog;
+	HPL::lexer lex;
+	std::deque<HPL::token> buffer; // Tokens that were peeked at but not read yet.
+	size_t lastEnd = 0; // End of the last read token.
+
+	parser(HPL::program& p) : prog(p), lex(p.source) {}
+
+	HPL::token& peek(size_t i = 0) {
+		while (buffer.size() <= i)
+			buffer.push_back(lex.next());
+
+		return buffer[i];
+	}
+
+	HPL::token next() {
+		HPL::token tok = peek();
+		buffer.pop_front();
+
+		if (tok.type != HPL::TOKEN_NEWLINE && tok.type != HPL::TOKEN_EOF)
+			lastEnd = tok.end;
+
+		return tok;
+	}
+
+	std::string_view slice(size_t begin, size_t end) { return prog.source.substr(begin, end - begin); }
+
+	void error(const HPL::token& tok, std::string msg) {
+		HPL::lineCount = tok.line;
+		HPL::throwError(true, msg);
+	}
+
+	void skipNewlines() {
+		while (peek().type == HPL::TOKEN_NEWLINE)
+			next();
+	}
+
+	bool isEnd(const HPL::token& tok) { return tok.type == HPL::TOKEN_NEWLINE || tok.type == HPL::TOKEN_EOF || tok.is("}"); }
+
+	// Reads a value until the end of the statement and returns its source. If
+	// 'stopAtComma' is enabled, a comma outside of brackets ends the value too.
+	std::string readValue(bool stopAtComma);
+	// Reads the source between the '(' and its closing ')'.
+	std::string readParens();
+	// Reads a '.' separated path of identifiers (eg. 'HPL_currentMod.path').
+	std::string readPath();
+	// Reads a type, which might be a list or a map of it (eg. 'int[]' or 'int[string]').
+	HPL::atom readType();
+	// Counts the tokens of the type at the front (eg. 3 for 'int[]').
+	size_t typeLength();
+
+	// Checks if the '{' that was just read ends its line, which makes it a block of HSM code.
+	bool isRawBlock();
+
+	void readBlock(std::vector<HPL::node>& body);
+	// Skips over a block without parsing it and returns its source, from the '{' to the '}'.
+	std::string_view skipBlock();
+	HPL::node readStatement();
+
+	void readDirective(HPL::node& n);
+	void readStruct(HPL::node& n);
+	void readFunction(HPL::node& n);
+	void readCondition(HPL::node& n);
+	void readLoop(HPL::node& n);
+	void readDeclaration(HPL::node& n);
+};
+
+
+std::string parser::readValue(bool stopAtComma) {
+	int depth = 0;
+	size_t begin = peek().begin, end = begin;
+
+	while (true) {
+		HPL::token& tok = peek();
+
+		if (tok.type == HPL::TOKEN_EOF || (tok.type == HPL::TOKEN_NEWLINE && depth == 0))
+			break;
+
+		if (depth == 0) {
+			if ((stopAtComma && tok.is(",")) || tok.is(")") || tok.is("}"))
+				break;
+		}
+
+		if (tok.is("(") || tok.is("{") || tok.is("["))
+			depth++;
+		else if (tok.is(")") || tok.is("}") || tok.is("]"))
+			depth--;
+
+		if (tok.type != HPL::TOKEN_NEWLINE)
+			end = tok.end;
+		next();
+	}
+
+	return std::string(slice(begin, end));
+}
+
+
+std::string parser::readParens() {
+	HPL::token open = next(); // '('
+	int depth = 1;
+
+	while (true) {
+		HPL::token tok = next();
+
+		if (tok.type == HPL::TOKEN_EOF)
+			error(open, "Missing a closing ')'.");
+		else if (tok.is("(") || tok.is("{") || tok.is("["))
+			depth++;
+		else if (tok.is(")") || tok.is("}") || tok.is("]"))
+			depth--;
+
+		if (depth == 0)
+			return std::string(slice(open.end, tok.begin));
+	}
+}
+
+
+std::string parser::readPath() {
+	std::string path = std::string(next().text);
+
+	while (peek().is(".") && peek(1).type == HPL::TOKEN_IDENTIFIER) {
+		next();
+		path += "." + std::string(next().text);
+	}
+
+	return path;
+}
+
+
+HPL::atom parser::readType() {
+	size_t length = typeLength();
+	std::string type;
+
+	for (size_t i = 0; i < length; i++)
+		type += next().text;
+
+	return HPL::atom(type);
+}
+
+
+size_t parser::typeLength() {
+	size_t length = 1;
+
+	while (peek(length).is("[")) {
+		if (peek(length + 1).is("]"))
+			length += 2;
+		else if (peek(length + 1).type == HPL::TOKEN_IDENTIFIER && peek(length + 2).is("]"))
+			length += 3;
+		else
+			break;
+	}
+
+	return length;
+}
+
+
+void parser::readBlock(std::vector<HPL::node>& body) {
+	skipNewlines();
+	HPL::token open = next();
+
+	if (!open.is("{"))
+		error(open, "Expected a '{' to open the block, got '" + std::string(open.text) + "' instead.");
+
+	while (true) {
+		skipNewlines();
+		HPL::token& tok = peek();
+
+		if (tok.is("}")) {
+			next();
+			return;
+		}
+		else if (tok.type == HPL::TOKEN_EOF)
+			error(open, "Missing a closing '}' for the block.");
+
+		body.push_back(readStatement());
+	}
+}
+
+
+bool parser::isRawBlock() {
+	size_t i = lex.pos;
+	while (i < prog.source.size() && (prog.source[i] == ' ' || prog.source[i] == '\t' || prog.source[i] == '\r'))
+		i++;
+
+	return (i >= prog.source.size() || prog.source[i] == '\n' || prog.source[i] == '#' || prog.source.compare(i, 2, "//") == 0);
+}
+
+
+std::string_view parser::skipBlock() {
+	skipNewlines();
+	HPL::token open = next();
+	int depth = 1;
+
+	if (!open.is("{"))
+		error(open, "Expected a '{' to open the block, got '" + std::string(open.text) + "' instead.");
+
+	while (true) {
+		HPL::token& tok = peek();
+
+		if (tok.type == HPL::TOKEN_EOF)
+			error(open, "Missing a closing '}' for the block.");
+
+		// HSM code can't be tokenized, so it's skipped by lines just like 'readDeclaration' reads it.
+		if (tok.is("scope") && peek(1).type == HPL::TOKEN_IDENTIFIER && peek(2).is("=") && peek(3).is("{") && buffer.size() == 4 && isRawBlock()) {
+			int firstLine;
+
+			buffer.clear();
+			lex.readRawBlock(firstLine);
+			continue;
+		}
+
+		HPL::token t = next();
+
+		if (t.is("{"))
+			depth++;
+		else if (t.is("}") && --depth == 0)
+			return slice(open.begin, t.end);
+	}
+}
+
+
+HPL::node parser::readStatement() {
+	HPL::token first = peek();
+	HPL::node n = {.line = first.line};
+	bool rawBlock = false;
+
+	if (first.type == HPL::TOKEN_DIRECTIVE)
+		readDirective(n);
+	else if (first.is("struct"))
+		readStruct(n);
+	else if (first.is("if"))
+		readCondition(n);
+	else if (first.is("for") && peek(1).type == HPL::TOKEN_IDENTIFIER && (peek(2).is("in") || peek(2).is(",")))
+		readLoop(n);
+	else if (first.is("return")) {
+		next();
+		n.type = HPL::NODE_RETURN;
+		n.values.push_back(HPL::parseExpression(readValue(false)));
+	}
+	else if (first.type == HPL::TOKEN_IDENTIFIER && peek(1).is("(")) {
+		n.type = HPL::NODE_CALL;
+		n.name = std::string(next().text);
+		n.values.push_back(HPL::parseCall(n.name, readParens()));
+	}
+	else if (first.type == HPL::TOKEN_IDENTIFIER && peek(typeLength()).type == HPL::TOKEN_IDENTIFIER) {
+		if (peek(typeLength() + 1).is("("))
+			readFunction(n);
+		else {
+			readDeclaration(n);
+			rawBlock = (n.type == HPL::NODE_SCOPE);
+		}
+	}
+	else if (first.type == HPL::TOKEN_IDENTIFIER) {
+		n.name = readPath();
+		HPL::expression element;
+
+		// An element of a list (eg. 'a[i]' or 'a[i].b').
+		if (peek().is("[")) {
+			int depth = 0;
+
+			do {
+				HPL::token tok = next();
+
+				if (tok.type == HPL::TOKEN_EOF || tok.type == HPL::TOKEN_NEWLINE)
+					error(first, "Missing a closing ']' for '" + n.name + "'.");
+				else if (tok.is("["))
+					depth++;
+				else if (tok.is("]"))
+					depth--;
+			} while (depth != 0);
+
+			while (peek().is(".") && peek(1).type == HPL::TOKEN_IDENTIFIER) {
+				next();
+				next();
+			}
+
+			n.name = std::string(slice(first.begin, lastEnd));
+			element = HPL::parseExpression(n.name);
+
+			if (element.type != HPL::EXPRESSION_INDEX)
+				error(first, "Invalid syntax ('" + n.name + "' can't be edited, as only a single index is supported).");
+		}
+
+		HPL::token op = next();
+
+		if (op.is("=")) {
+			n.type = HPL::NODE_ASSIGNMENT;
+			n.values.push_back(HPL::parseExpression(readValue(false)));
+		}
+		else if (op.is("++") || op.is("--") || op.is("+=") || op.is("-=") || op.is("*=") || op.is("/=") || op.is("%=")) {
+			n.type = HPL::NODE_MATH;
+			n._operator = std::string(op.text);
+			n.values.push_back(HPL::parseExpression(readValue(false)));
+		}
+		else
+			error(op, "Invalid syntax ('" + std::string(op.text) + "' isn't a valid operator for '" + n.name + "').");
+
+		if (element.type == HPL::EXPRESSION_INDEX)
+			n.values.push_back(std::move(element));
+	}
+	else
+		error(first, "Invalid syntax (Unexpected '" + std::string(first.text) + "').");
+
+	n.text = slice(first.begin, lastEnd);
+
+	if (!rawBlock && !isEnd(peek()))
+		error(peek(), "Invalid syntax (Unexpected '" + std::string(peek().text) + "' at the end of the statement).");
+
+	return n;
+}
+
+
+void parser::readDirective(HPL::node& n) {
+	HPL::token tok = next();
+	std::vector<std::string> parts = split(tok.text, "//", "\"\""); // Empty if there's only a comment after the '#'.
+	std::string_view text = (parts.empty() ? std::string_view() : removeFrontAndBackSpaces(parts[0]));
+
+	if (text.starts_with("include")) {
+		std::string_view file = removeFrontAndBackSpaces(text.substr(7));
+		n.type = HPL::NODE_INCLUDE;
+
+		if (file.size() > 2 && file.front() == '<' && file.back() == '>')
+			n.coreInclude = true;
+		else if (!(file.size() > 2 && file.front() == '"' && file.back() == '"'))
+			error(tok, "Invalid include (Must be either '#include <file>' or '#include \"file\"').");
+
+		n.name = file.substr(1, file.size() - 2);
+	}
+	else if (text == "read once")
+		n.type = HPL::NODE_READ_ONCE;
+	else
+		error(tok, "Unknown directive '#" + std::string(text) + "'.");
+}
+
+
+void parser::readStruct(HPL::node& n) {
+	next(); // 'struct'
+	HPL::token name = next();
+
+	if (name.type != HPL::TOKEN_IDENTIFIER)
+		error(name, "Invalid struct name '" + std::string(name.text) + "'.");
+
+	n.type = HPL::NODE_STRUCT;
+	n.name = std::string(name.text);
+	readBlock(n.body);
+
+	for (const auto& member : n.body) {
+		if (member.type != HPL::NODE_DECLARATION) {
+			HPL::lineCount = member.line;
+			HPL::throwError(true, "Only variable declarations can be inside of a struct (struct '%s').", n.name.c_str());
+		}
+	}
+}
+
+
+void parser::readFunction(HPL::node& n) {
+	n.type = HPL::NODE_FUNCTION;
+	n.valueType = readType();
+	n.name = std::string(next().text);
+	next(); // '('
+
+	while (!peek().is(")")) {
+		HPL::token type = peek();
+		HPL::atom typeName = readType();
+		HPL::token name = next();
+
+		if (type.type != HPL::TOKEN_IDENTIFIER || name.type != HPL::TOKEN_IDENTIFIER)
+			error(type, "Invalid param in function '" + n.name + "' (format is '<type> <name> [= value]').");
+
+		HPL::variable var = {typeName, HPL::atom(name.text)};
+
+		if (peek().is("=")) {
+			next();
+			var.value = unstringify(readValue(true));
+		}
+		else
+			n.minParamCount++;
+
+		n.params.push_back(var);
+
+		if (peek().is(","))
+			next();
+		else if (!peek().is(")"))
+			error(peek(), "Expected ',' or ')' in the params of function '" + n.name + "'.");
+	}
+	next(); // ')'
+
+	// Only the source is kept, the body gets parsed once the function is called.
+	n.bodySource = skipBlock();
+}
+
+
+void parser::readCondition(HPL::node& n) {
+	HPL::token first = next(); // 'if'
+	n.type = HPL::NODE_IF;
+
+	while (!peek().is("{") && peek().type != HPL::TOKEN_NEWLINE && peek().type != HPL::TOKEN_EOF) {
+		HPL::token& tok = peek();
+
+		if (tok.is("==") || tok.is("!=") || tok.is(">=") || tok.is("<=") || tok.is(">") || tok.is("<") || tok.is("&&") || tok.is("||"))
+		{
+			n.values.push_back({HPL::EXPRESSION_OTHER, std::string(next().text)});
+			HPL::addConstant(n.values.back());
+		}
+		else {
+			// Read the operand until the next operator.
+			int depth = 0;
+			size_t begin = tok.begin, end = tok.end;
+
+			while (true) {
+				HPL::token& t = peek();
+
+				if (t.type == HPL::TOKEN_EOF || t.type == HPL::TOKEN_NEWLINE)
+					break;
+				if (depth == 0 && (t.is("{") || t.is("==") || t.is("!=") || t.is(">=") || t.is("<=") || t.is(">") || t.is("<") || t.is("&&") || t.is("||")))
+					break;
+
+				if (t.is("(") || t.is("["))
+					depth++;
+				else if (t.is(")") || t.is("]"))
+					depth--;
+
+				end = t.end;
+				next();
+			}
+
+			n.values.push_back(HPL::parseExpression(slice(begin, end)));
+		}
+	}
+
+	if (n.values.empty())
+		error(first, "An if statement requires a condition.");
+
+	readBlock(n.body);
+}
+
+
+void parser::readLoop(HPL::node& n) {
+	HPL::token first = next(); // 'for'
+	n.type = HPL::NODE_FOR;
+	n.names.push_back(HPL::atom(next().text));
+
+	if (peek().is(",")) { // 'for <index/key>, <element> in <list/map>'
+		next();
+		HPL::token name = next();
+
+		if (name.type != HPL::TOKEN_IDENTIFIER)
+			error(name, "Invalid variable name '" + std::string(name.text) + "'.");
+
+		n.names.push_back(HPL::atom(name.text));
+	}
+
+	if (!peek().is("in"))
+		error(peek(), "Expected 'in' after the names of the for loop (format is 'for <name> in <list>').");
+	next(); // 'in'
+
+	// The list is read until the block's '{'.
+	int depth = 0;
+	size_t begin = peek().begin, end = begin;
+
+	while (true) {
+		HPL::token& t = peek();
+
+		if (t.type == HPL::TOKEN_EOF || t.type == HPL::TOKEN_NEWLINE || (depth == 0 && t.is("{")))
+			break;
+
+		if (t.is("(") || t.is("["))
+			depth++;
+		else if (t.is(")") || t.is("]"))
+			depth--;
+
+		end = t.end;
+		next();
+	}
+
+	if (begin == end)
+		error(first, "A for loop requires a list to go through (format is 'for <name> in <list>').");
+
+	n.values.push_back(HPL::parseExpression(slice(begin, end)));
+	readBlock(n.body);
+}
+
+
+void parser::readDeclaration(HPL::node& n) {
+	n.type = HPL::NODE_DECLARATION;
+	n.valueType = readType();
+
+	while (true) {
+		HPL::token name = next();
+
+		if (name.type != HPL::TOKEN_IDENTIFIER)
+			error(name, "Invalid variable name '" + std::string(name.text) + "'.");
+
+		n.names.push_back(HPL::atom(name.text));
+
+		if (!peek().is(","))
+			break;
+		next();
+	}
+
+	if (!peek().is("="))
+		return;
+	next();
+
+	// 'scope <name> = {' followed by a new line is a block of HSM code.
+	if (n.valueType == HPL::atom::SCOPE && peek().is("{") && buffer.size() == 1) {
+		if (isRawBlock()) {
+			HPL::token open = next();
+			int firstLine;
+
+			if (n.names.size() != 1)
+				error(open, "Only one scope can be declared with a block.");
+
+			n.type = HPL::NODE_SCOPE;
+			n.name = n.names[0];
+			n.lines = lex.readRawBlock(firstLine);
+			lastEnd = lex.pos;
+
+			return;
+		}
+	}
+
+	while (true) {
+		n.values.push_back(HPL::parseExpression(readValue(true)));
+
+		if (!peek().is(","))
+			break;
+		next();
+	}
+}
+
+
+void HPL::parseProgram(program& prog, int firstLine/* = 1*/) {
+	parser p(prog);
+	p.lex.line = firstLine;
+
+	while (true) {
+		p.skipNewlines();
+
+		if (p.peek().type == HPL::TOKEN_EOF)
+			break;
+
+		prog.body.push_back(p.readStatement());
+	}
+	// Count the lines like 'fgets' would, a trailing new line doesn't start a new line.
+	prog.lineCount = std::count(prog.source.begin(), prog.source.end(), '\n');
+	if (!prog.source.empty() && prog.source.back() != '\n')
+		prog.lineCount++;
+}
+
+
+void HPL::parseFunctionBody(const node& definition, const std::string& file) {
+	if (definition.bodySource.empty())
+		return;
+
+	// The programs own their nodes, so they can be changed even though everyone else only reads them.
+	node& n = const_cast<node&>(definition);
+	program body;
+	body.source = n.bodySource;
+
+	std::string oldFile = curFile;
+	int oldLineCount = lineCount;
+	curFile = file;
+
+	parser p(body);
+	p.lex.line = n.line + std::count(n.text.data(), n.bodySource.data(), '\n');
+	p.readBlock(n.body);
+	n.bodySource = {};
+
+	curFile = oldFile;
+	lineCount = oldLineCount;
+}
+
+
+// Checks if the text is a variable or a member of a struct (eg. 'HPL_currentMod.path').
+static bool isPath(std::string_view text) {
+	bool newName = true;
+
+	for (char c : text) {
+		if (c == '.' && !newName)
+			newName = true;
+		else if (std::isalpha((unsigned char)c) || c == '_' || (std::isdigit((unsigned char)c) && !newName))
+			newName = false;
+		else
+			return false;
+	}
+
+	return !newName;
+}
+
+
+// Splits '<list>[<index>]' and '<list>[<index>].<member>' into their parts. Only a single index is supported.
+static bool matchIndex(const std::string& value, std::string& list, std::string& index, std::string& member) {
+	size_t open = value.find('['), close = open;
+	int depth = 0;
+
+	if (open == std::string::npos || !isPath(std::string_view(value).substr(0, open)))
+		return false;
+
+	for (; close < value.size(); close++) {
+		if (value[close] == '[')
+			depth++;
+		else if (value[close] == ']' && --depth == 0)
+			break;
+	}
+
+	if (close == value.size())
+		return false;
+
+	std::string_view rest = std::string_view(value).substr(close + 1);
+
+	if (!rest.empty() && (rest.front() != '.' || !isPath(rest.substr(1))))
+		return false;
+
+	list = value.substr(0, open);
+	index = removeFrontAndBackSpaces(std::string_view(value).substr(open + 1, close - open - 1));
+	member = (rest.empty() ? "" : std::string(rest.substr(1)));
+
+	return !index.empty();
+}
+
+
+HPL::expression HPL::parseExpression(std::string_view text) {
+	expression expr = {EXPRESSION_OTHER, std::string(removeFrontAndBackSpaces(text))};
+	const std::string& value = expr.text;
+
+	// The order is the same as the one 'setCorrectValue' checks the value in.
+	if (value.empty())
+		expr.type = EXPRESSION_EMPTY;
+
+	else if (isStr(value)) {
+		// '"a" + b' gets put together at runtime.
+		if (split(value, "+", "\"\"(){}").size() != 1)
+			return expr;
+
+		expr.type = (value.front() == 'f' ? EXPRESSION_FSTRING : EXPRESSION_STRING);
+
+		if (expr.type == EXPRESSION_FSTRING) {
+			useIterativeRegex(value, R"(\{([\w\(\)\[\]\.]+)\})");
+			std::vector<std::string> values(HPL::matches.value.begin(), HPL::matches.value.end());
+
+			for (const auto& v : values)
+				expr.args.push_back(parseExpression(v));
+		}
+	}
+
+	else if (isInt(value))
+		expr.type = EXPRESSION_NUMBER;
+
+	else if (value == "true" || value == "false")
+		expr.type = EXPRESSION_BOOL;
+
+	else if (value.front() == '{' && value.back() == '}') {
+		// Commas inside of strings and nested braces (eg. a list of structs) don't split the members.
+		expr.type = EXPRESSION_STRUCT;
+
+		for (const auto& v : split(unstringify(value, true), ",", "(){}[]\"\"")) {
+			std::string_view member = removeFrontAndBackSpaces(v);
+
+			if (member.empty())
+				continue;
+
+			// Map entries are split into their key and value here, instead of every time that the map is made.
+			std::vector<std::string> pair = split(member, ":", "(){}[]\"\"");
+
+			if (pair.size() == 2)
+				expr.args.push_back({EXPRESSION_PAIR, std::string(member), "", {parseExpression(pair[0]), parseExpression(pair[1])}});
+			else
+				expr.args.push_back(parseExpression(member));
+		}
+	}
+
+	else if (std::string list, index, member; matchIndex(value, list, index, member)) {
+		expr.type = EXPRESSION_INDEX;
+		expr.name = list;
+		expr.args.push_back(parseExpression(index));
+
+		if (!member.empty())
+			expr.args.push_back({EXPRESSION_VARIABLE, member});
+	}
+
+	else if (matchFunctionCall(value))
+		return parseCall(HPL::matches.view(1), HPL::matches.view(2));
+
+	else if (isPath(value)) // A variable or a member of a struct (eg. 'HPL_currentMod.path').
+		expr.type = EXPRESSION_VARIABLE;
+
+	addConstant(expr);
+
+	return expr;
+}
+
+
+void HPL::addConstant(expression& expr) {
+	static std::unordered_map<std::string, int> found; // Index of the literal, found by its text.
+	constant c;
+
+	switch (expr.type) {
+		case EXPRESSION_STRING:
+			c.value = {.type = HPL::atom::STRING, .value = convertBackslashes(std::string(unstringify(expr.text)))};
+			break;
+
+		case EXPRESSION_NUMBER:
+			c.value.type = getTypeFromValue(expr.text);
+			c.other.type = (c.value.type == HPL::atom::INT ? HPL::atom::FLOAT : HPL::atom::INT);
+
+			for (auto* number : {&c.value, &c.other}) {
+				if (number->type == HPL::atom::INT)
+					number->value = xToType<int>(expr.text);
+				else
+					number->value = xToType<float>(expr.text);
+			}
+			break;
+
+		case EXPRESSION_BOOL:
+			c.value = {.type = HPL::atom::BOOL, .value = (expr.text == "true")};
+			break;
+
+		case EXPRESSION_OTHER:
+			c.value.type = getTypeFromValue(expr.text);
+			if (c.value.type != HPL::atom::RELATIONAL_OPERATOR && c.value.type != HPL::atom::LOGICAL_OPERATOR)
+				return;
+
+			c.value.value = expr.text;
+			break;
+
+		default:
+			return;
+	}
+
+	auto [it, inserted] = found.try_emplace(expr.text, constants.size());
+	if (inserted)
+		constants.push_back(std::move(c));
+
+	expr.constant = it->second;
+}
+
+
+std::vector<HPL::expression> HPL::parseArguments(std::string_view params) {
+	std::vector<expression> args;
+
+	for (const auto& p : split(params, ",", "(){}\"\"")) {
+		std::string_view value = removeFrontAndBackSpaces(p);
+
+		// Out of order argument.
+		if (!value.empty() && find(value, "=") && !isStr(value) && matchNamedParam(value)) {
+			expression arg = {EXPRESSION_NAMED, std::string(value), HPL::matches.str(1)};
+			arg.args.push_back(parseExpression(HPL::matches.view(2)));
+
+			args.push_back(arg);
+		}
+		else
+			args.push_back(parseExpression(value));
+	}
+
+	return args;
+}
+
+
+HPL::expression HPL::parseCall(std::string_view name, std::string_view params) {
+	return {EXPRESSION_CALL, std::string(name) + "(" + std::string(params) + ")", std::string(name), parseArguments(params)};
+}
+
+
+namespace HPL {
+	std::list<program> programs;
+	std::vector<constant> constants;
+}
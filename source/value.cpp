@@ -0,0 +1,260 @@
+/*
+* Copyright (C) 2022-2023 EimaMei/Sacode
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+*    claim that you wrote the original software. If you use this software
+*    in a product, an acknowledgment in the product documentation would be
+*    appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+*    misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*
+*
+*/
+
+#include <value.hpp>
+#include <interpreter.hpp>
+#include <helper.hpp>
+
+
+HPL::value::value(const std::vector<variable>& vars) {
+	set<counted*>(new shared<std::vector<variable>>(vars), VARS);
+}
+
+
+HPL::value::value(std::vector<variable>&& vars) {
+	set<counted*>(new shared<std::vector<variable>>(std::move(vars)), VARS);
+}
+
+
+HPL::value::value(const list& items) {
+	set<counted*>(new shared<list>(items), LIST);
+}
+
+
+HPL::value::value(list&& items) {
+	set<counted*>(new shared<list>(std::move(items)), LIST);
+}
+
+
+HPL::value::value(const map& entries) {
+	set<counted*>(new shared<map>(entries), MAP);
+}
+
+
+HPL::value::value(map&& entries) {
+	set<counted*>(new shared<map>(std::move(entries)), MAP);
+}
+
+
+HPL::value& HPL::value::operator=(const value& other) {
+	// The other value might be inside of this one (eg. a struct's member), so it's copied first.
+	value output(other);
+	return *this = std::move(output);
+}
+
+
+HPL::value& HPL::value::operator=(value&& other) noexcept {
+	value output(std::move(other));
+
+	release();
+	take(output);
+
+	return *this;
+}
+
+
+std::string_view HPL::value::str() const {
+	if (tag == SHORT_STRING)
+		return std::string_view(data, (uint8_t)data[shortLength]);
+
+	return static_cast<shared<std::string>*>(block())->data;
+}
+
+
+std::string& HPL::value::string() {
+	if (tag == SHORT_STRING)
+		set<counted*>(new shared<std::string>(std::string(str())), STRING);
+	else if (block()->refs > 1) {
+		block()->refs--;
+		set<counted*>(new shared<std::string>(static_cast<shared<std::string>*>(block())->data), STRING);
+	}
+
+	return static_cast<shared<std::string>*>(block())->data;
+}
+
+
+void HPL::value::append(std::string_view text) {
+	if (tag == NOTHING)
+		setStr("");
+
+	if (tag == SHORT_STRING) {
+		size_t length = (uint8_t)data[shortLength];
+
+		if (length + text.size() <= shortLength) {
+			std::memmove(data + length, text.data(), text.size());
+			data[shortLength] = (char)(length + text.size());
+			return;
+		}
+
+		// The text might be this very string, so it's copied before the bytes turn into a pointer.
+		std::string output;
+		output.reserve(2 * (length + text.size()));
+		output.append(str()).append(text);
+
+		set<counted*>(new shared<std::string>(std::move(output)), STRING);
+		return;
+	}
+
+	string().append(text);
+}
+
+
+std::vector<HPL::variable>& HPL::value::vars() {
+	if (block()->refs > 1) {
+		block()->refs--;
+		set<counted*>(new shared<std::vector<variable>>(static_cast<shared<std::vector<variable>>*>(block())->data), VARS);
+	}
+
+	return static_cast<shared<std::vector<variable>>*>(block())->data;
+}
+
+
+const HPL::list& HPL::value::items() const {
+	return static_cast<shared<list>*>(block())->data;
+}
+
+
+HPL::list& HPL::value::items() {
+	if (block()->refs > 1) {
+		block()->refs--;
+		set<counted*>(new shared<list>(static_cast<shared<list>*>(block())->data), LIST);
+	}
+
+	return static_cast<shared<list>*>(block())->data;
+}
+
+
+const HPL::map& HPL::value::entries() const {
+	return static_cast<shared<map>*>(block())->data;
+}
+
+
+HPL::map& HPL::value::entries() {
+	if (block()->refs > 1) {
+		block()->refs--;
+		set<counted*>(new shared<map>(static_cast<shared<map>*>(block())->data), MAP);
+	}
+
+	return static_cast<shared<map>*>(block())->data;
+}
+
+
+void HPL::value::setStr(std::string_view str) {
+	if (str.size() <= shortLength) {
+		std::memcpy(data, str.data(), str.size());
+		data[shortLength] = (char)str.size();
+		tag = SHORT_STRING;
+	}
+	else
+		set<counted*>(new shared<std::string>(std::string(str)), STRING);
+}
+
+
+void HPL::value::releaseAllocated() {
+	if (tag == STRING)
+		delete static_cast<shared<std::string>*>(block());
+	else if (tag == LIST)
+		delete static_cast<shared<list>*>(block());
+	else if (tag == MAP)
+		delete static_cast<shared<map>*>(block());
+	else
+		delete static_cast<shared<std::vector<variable>>*>(block());
+
+	tag = NOTHING;
+}
+
+
+HPL::list::list(atom elementType) : type(elementType), shape(getStructFromName(elementType)) {
+	columns.resize(shape == nullptr ? 1 : shape->value.size());
+}
+
+
+int HPL::list::column(atom member) const {
+	if (shape == nullptr)
+		return -1;
+
+	for (size_t i = 0; i < shape->value.size(); i++) {
+		if (shape->value[i].name == member)
+			return i;
+	}
+
+	return -1;
+}
+
+
+HPL::variable HPL::list::at(size_t index) const {
+	variable element = {.type = type};
+
+	if (shape == nullptr) {
+		element.value = columns[0][index];
+		return element;
+	}
+
+	std::vector<variable> vars = shape->value;
+	for (size_t i = 0; i < vars.size(); i++)
+		vars[i].value = columns[i][index];
+
+	element.value = std::move(vars);
+	return element;
+}
+
+
+void HPL::list::set(size_t index, const variable& element) {
+	if (shape == nullptr) {
+		columns[0][index] = element.value;
+		return;
+	}
+
+	static const std::vector<variable> none;
+	const auto& vars = (isVars(element.value) ? getVars(element.value) : none);
+
+	const auto& members = shape->value;
+
+	for (size_t i = 0; i < members.size(); i++)
+		columns[i][index] = (i < vars.size() ? vars[i].value : members[i].value);
+}
+
+
+void HPL::list::push_back(const variable& element) {
+	for (auto& column : columns)
+		column.emplace_back();
+
+	set(length++, element);
+}
+
+
+int HPL::map::find(const value& key) const {
+	auto found = positions.find(xToStr(key));
+	return (found != positions.end() ? (int)found->second : -1);
+}
+
+
+size_t HPL::map::insert(const variable& key) {
+	auto [found, inserted] = positions.try_emplace(xToStr(key.value), size());
+
+	if (inserted) {
+		keys.push_back(key);
+		values.push_back({.type = values.type});
+	}
+
+	return found->second;
+}
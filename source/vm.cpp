@@ -0,0 +1,952 @@
+/*
+* Copyright (C) 2022-2023 EimaMei/Sacode
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+*    claim that you wrote the original software. If you use this software
+*    in a product, an acknowledgment in the product documentation would be
+*    appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+*    misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*
+*
+*/
+
+#include <vm.hpp>
+#include <core.hpp>
+#include <helper.hpp>
+#include <arena.hpp>
+
+#include <iostream>
+#include <unordered_map>
+
+
+// Compiled files and function bodies. Programs and nodes never move, so they can be used as the key.
+static std::unordered_map<const HPL::program*, HPL::chunk> compiledPrograms;
+static std::unordered_map<const HPL::node*, HPL::chunk> compiledFunctions;
+
+
+struct compiler {
+	HPL::chunk& output;
+	bool useSlots;                   // If the variables are given slots.
+	std::vector<std::string> locals; // Names of the variables in slot order.
+	int blockDepth = 0;
+	std::vector<size_t> returns;     // Returns outside of functions that have to jump to the end of the outermost block.
+
+	size_t emit(HPL::OPCODE op, int a = 0, int b = 0) {
+		output.code.push_back({op, a, b});
+		return output.code.size() - 1;
+	}
+
+	int addSite(HPL::site s) {
+		output.sites.push_back(std::move(s));
+		return output.sites.size() - 1;
+	}
+
+	// Variables are always looked up from the start, so the first one with the name wins.
+	int findLocal(const std::string& name) {
+		if (!useSlots)
+			return -1;
+
+		for (size_t i = 0; i < locals.size(); i++) {
+			if (locals[i] == name)
+				return i;
+		}
+
+		return -1;
+	}
+
+	// Sets the site's slot and path if the variable is local.
+	HPL::site variableSite(const std::string& name) {
+		HPL::site s = {.name = name};
+		auto members = split(name, ".");
+
+		s.slot = findLocal(members[0]);
+
+		if (s.slot != -1) {
+			s.members.base = HPL::atom(members[0]);
+			for (size_t i = 1; i < members.size(); i++)
+				s.members.path.push_back(HPL::atom(members[i]));
+		}
+
+		return s;
+	}
+};
+
+
+// Checks if the expression doesn't call anything, so it's safe to evaluate it more than once.
+static bool isPure(const HPL::expression& expr) {
+	if (expr.type == HPL::EXPRESSION_CALL || expr.type == HPL::EXPRESSION_OTHER)
+		return false;
+
+	for (const auto& arg : expr.args) {
+		if (!isPure(arg))
+			return false;
+	}
+
+	return true;
+}
+
+
+// Checks if the body has an include, which would add variables that the compiler doesn't know about.
+// Functions that weren't parsed yet might have one too.
+static bool hasInclude(const std::vector<HPL::node>& body) {
+	for (const auto& statement : body) {
+		if (statement.type == HPL::NODE_INCLUDE || !statement.bodySource.empty() || hasInclude(statement.body))
+			return true;
+	}
+
+	return false;
+}
+
+
+static void compileValue(compiler& c, const HPL::expression& expr);
+
+
+static void compileCall(compiler& c, const HPL::expression& call) {
+	HPL::site s = {.value = &call, .name = call.name, .function = HPL::atom(call.name)};
+
+	for (const auto& arg : call.args) {
+		if (arg.type == HPL::EXPRESSION_NAMED) {
+			compileValue(c, arg.args[0]);
+			s.named.push_back(HPL::atom(arg.name));
+		}
+		else {
+			compileValue(c, arg);
+			s.named.push_back(HPL::atom());
+		}
+	}
+
+	c.emit(HPL::OP_CALL, c.addSite(std::move(s)), call.args.size());
+}
+
+
+// Compiles the expression so that it pushes exactly one value.
+static void compileValue(compiler& c, const HPL::expression& expr) {
+	switch (expr.type) {
+		case HPL::EXPRESSION_STRING:
+		case HPL::EXPRESSION_NUMBER:
+		case HPL::EXPRESSION_BOOL: {
+			c.emit(HPL::OP_CONSTANT, expr.constant, c.addSite({.value = &expr}));
+			return;
+		}
+
+		case HPL::EXPRESSION_FSTRING:
+			if (!isPure(expr))
+				break;
+
+			for (const auto& value : expr.args)
+				compileValue(c, value);
+
+			c.emit(HPL::OP_FSTRING, c.addSite({.value = &expr}), expr.args.size());
+			return;
+
+		case HPL::EXPRESSION_VARIABLE: {
+			HPL::site s = c.variableSite(expr.text);
+			s.value = &expr;
+
+			if (s.slot == -1)
+				c.emit(HPL::OP_LOAD_NAME, c.addSite(std::move(s)));
+			else if (s.members.path.empty())
+				c.emit(HPL::OP_LOAD_LOCAL, c.addSite(std::move(s)));
+			else
+				c.emit(HPL::OP_LOAD_MEMBER, c.addSite(std::move(s)));
+			return;
+		}
+
+		case HPL::EXPRESSION_CALL:
+			compileCall(c, expr);
+			return;
+
+		default:
+			break;
+	}
+
+	// Struct literals depend on the type that they're stored in, so they (and anything else) get evaluated then.
+	c.emit(HPL::OP_EXPRESSION, c.addSite({.value = &expr}));
+}
+
+
+// Compiles a value that's stored inside of a variable, whose type is only known at runtime.
+// A call's output can't be directly stored in every type, so those get checked first.
+static void compileStoredValue(compiler& c, const HPL::expression& expr, HPL::site target, HPL::OPCODE store) {
+	int targetSite = c.addSite(std::move(target));
+
+	if (expr.type == HPL::EXPRESSION_CALL) {
+		size_t guard = c.emit(HPL::OP_GUARD, targetSite);
+		compileValue(c, expr);
+		c.output.code[guard].b = c.output.code.size();
+	}
+	else
+		compileValue(c, expr);
+
+	c.emit(store, targetSite);
+}
+
+
+static void compileBlock(compiler& c, const std::vector<HPL::node>& body);
+
+
+static void compileCondition(compiler& c, const HPL::node& statement) {
+	int conditionSite = c.addSite({.statement = &statement});
+
+	for (size_t i = 0; i < statement.values.size(); i++) {
+		const auto& value = statement.values[i];
+
+		if (value.text == "||") {
+			c.emit(HPL::OP_OR);
+			continue;
+		}
+		else if (value.text == "&&")
+			continue;
+
+		compileValue(c, value);
+
+		if (i + 2 < statement.values.size() && isOperator(statement.values[i + 1], HPL::atom::RELATIONAL_OPERATOR)) {
+			compileValue(c, statement.values[i + 2]);
+			c.emit(HPL::OP_COMPARE, c.addSite({.value = &statement.values[i + 1], .name = statement.values[i + 1].text}));
+
+			i += 2;
+		}
+		else
+			c.emit(HPL::OP_TRUTHY);
+	}
+
+	size_t jump = c.emit(HPL::OP_JUMP_IF_FALSE, 0, conditionSite);
+	size_t oldLocals = c.locals.size();
+
+	c.emit(HPL::OP_BLOCK_BEGIN);
+	c.blockDepth++;
+
+	compileBlock(c, statement.body);
+
+	c.blockDepth--;
+	c.emit(HPL::OP_BLOCK_END);
+	c.locals.resize(oldLocals);
+
+	c.output.code[jump].a = c.output.code.size();
+
+	if (c.blockDepth == 0) { // Returns that are outside of functions stop every block they're in.
+		for (auto index : c.returns)
+			c.output.code[index].b = c.output.code.size();
+
+		c.returns.clear();
+	}
+}
+
+
+static void compileStatement(compiler& c, const HPL::node& statement) {
+	static const HPL::expression noValue;
+
+	if (statement.type == HPL::NODE_READ_ONCE) {
+		if (!c.output.isFunction)
+			c.emit(HPL::OP_READ_ONCE);
+
+		return;
+	}
+
+	c.emit(HPL::OP_LINE, statement.line);
+
+	switch (statement.type) {
+		case HPL::NODE_INCLUDE:
+		case HPL::NODE_STRUCT:
+		case HPL::NODE_FUNCTION:
+			c.emit(HPL::OP_NODE, c.addSite({.statement = &statement}));
+			break;
+
+		case HPL::NODE_SCOPE:
+			c.emit(HPL::OP_NODE, c.addSite({.statement = &statement}));
+			c.locals.push_back(statement.name);
+			break;
+
+		case HPL::NODE_IF:
+			compileCondition(c, statement);
+			break;
+
+		case HPL::NODE_FOR: // A return inside of the loop stops it the same way that 'OP_RETURN' does.
+			c.emit(HPL::OP_NODE, c.addSite({.statement = &statement}));
+
+			if (!c.output.isFunction) {
+				if (c.blockDepth == 0)
+					c.output.code.back().b = c.output.code.size();
+				else
+					c.returns.push_back(c.output.code.size() - 1);
+			}
+			break;
+
+		case HPL::NODE_RETURN: {
+			const auto& value = statement.values[0];
+
+			if (value.type == HPL::EXPRESSION_EMPTY) // Nothing gets returned, so the function keeps going.
+				break;
+
+			compileStoredValue(c, value, {.statement = &statement}, HPL::OP_RETURN);
+
+			if (!c.output.isFunction) {
+				if (c.blockDepth == 0)
+					c.output.code.back().b = c.output.code.size();
+				else
+					c.returns.push_back(c.output.code.size() - 1);
+			}
+			break;
+		}
+
+		case HPL::NODE_DECLARATION: {
+			// The type is already known, so a call's output that can't be stored directly is left to the tree-walker.
+			bool evaluateCalls = (statement.valueType == HPL::atom::BOOL || statement.valueType == HPL::atom::SCOPE || statement.valueType == HPL::atom::STRUCT);
+
+			for (size_t i = 0; i < statement.names.size(); i++) {
+				const auto& value = (i < statement.values.size() ? statement.values[i] : noValue);
+
+				if (evaluateCalls && !isPure(value))
+					c.emit(HPL::OP_EXPRESSION, c.addSite({.value = &value}));
+				else
+					compileValue(c, value);
+
+				c.emit(HPL::OP_DECLARE, c.addSite({.statement = &statement, .value = &value}), i);
+				c.locals.push_back(statement.names[i]);
+			}
+			break;
+		}
+
+		case HPL::NODE_ASSIGNMENT: {
+			if (statement.values.size() > 1) { // Elements of lists are edited by the tree-walker.
+				c.emit(HPL::OP_NODE, c.addSite({.statement = &statement}));
+				break;
+			}
+
+			HPL::site target = c.variableSite(statement.name);
+			target.statement = &statement;
+
+			compileStoredValue(c, statement.values[0], std::move(target), HPL::OP_ASSIGN);
+			break;
+		}
+
+		case HPL::NODE_MATH: {
+			if (statement.values.size() > 1) {
+				c.emit(HPL::OP_NODE, c.addSite({.statement = &statement}));
+				break;
+			}
+
+			HPL::site target = c.variableSite(statement.name);
+			target.statement = &statement;
+			bool hasValue = (statement.values[0].type != HPL::EXPRESSION_EMPTY);
+
+			if (hasValue)
+				compileValue(c, statement.values[0]);
+
+			c.emit(HPL::OP_MATH, c.addSite(std::move(target)), hasValue);
+			break;
+		}
+
+		case HPL::NODE_CALL:
+			compileCall(c, statement.values[0]);
+			c.output.sites[c.output.code.back().a].statement = &statement;
+			c.emit(HPL::OP_POP);
+			break;
+
+		default:
+			break;
+	}
+}
+
+
+static void compileBlock(compiler& c, const std::vector<HPL::node>& body) {
+	for (const auto& statement : body)
+		compileStatement(c, statement);
+}
+
+
+const HPL::chunk& HPL::compileProgram(const program& prog) {
+	auto found = compiledPrograms.find(&prog);
+	if (found != compiledPrograms.end())
+		return found->second;
+
+	chunk& output = compiledPrograms[&prog];
+	compiler c = {output, false};
+
+	for (const auto& statement : prog.body) {
+		output.statements.push_back(output.code.size());
+		compileStatement(c, statement);
+	}
+
+	return output;
+}
+
+
+const HPL::chunk& HPL::compileFunction(const node& definition) {
+	auto found = compiledFunctions.find(&definition);
+	if (found != compiledFunctions.end())
+		return found->second;
+
+	chunk& output = compiledFunctions[&definition];
+	output.isFunction = true;
+
+	compiler c = {output, !hasInclude(definition.body)};
+
+	for (const auto& param : definition.params)
+		c.locals.push_back(param.name);
+
+	compileBlock(c, definition.body);
+	return output;
+}
+
+
+// A value on the VM's stack.
+struct stackValue {
+	HPL::variable var;
+	const HPL::expression* source = nullptr; // Null if the value was already stored.
+	bool evaluateLater = false;              // If the source still has to be evaluated.
+	HPL::atom returnType;                    // Return type of the called function.
+};
+
+
+// A function whose output is the output of the call that it made ('return f()'). The called
+// function takes over its stack and its blocks, so only what's needed to finish it is kept.
+// Its variables stay where they are, since the called function can still read them by their
+// names, and its blocks end once the called function returns.
+struct tailCall {
+	const HPL::chunk* code;
+	size_t pc, base;
+	size_t blocks;          // How many of the blocks are its own.
+	bool res, group;
+	HPL::arena::marker temporaries;
+	const HPL::site* call;  // The call, whose output gets returned.
+	pendingCall running;
+};
+
+
+// A function that called another one on the VM. Its state is kept here until the
+// called function returns, so calls don't recurse into 'runChunk'.
+struct frame {
+	const HPL::chunk* code;
+	size_t pc, base;
+	std::vector<stackValue> stack;
+	std::vector<size_t> blocks;
+	std::vector<signed char> shadowed;
+	std::vector<tailCall> tails;
+	bool res, group;
+	HPL::arena::marker temporaries;
+	const HPL::site* call;  // Where the output goes once the called function returns.
+	pendingCall running;    // The call that started this function, or nothing if 'runChunk' did.
+};
+
+
+// Stores the value inside of the variable with the same rules as 'evaluateExpression'.
+// Anything that the fast paths don't cover gets evaluated from the source again, which
+// is safe as only pure values get there.
+static bool storeValue(HPL::variable& var, stackValue& v, bool onlyChangeValue) {
+	if (v.evaluateLater)
+		return evaluateExpression(var, *v.source, onlyChangeValue);
+
+	bool autoType = (var.type.empty() || var.type == HPL::atom::AUTO);
+
+	switch (v.source->type) {
+		case HPL::EXPRESSION_VARIABLE:
+			if (!onlyChangeValue)
+				var = std::move(v.var);
+			else
+				var.value = std::move(v.var.value);
+
+			return true;
+
+		case HPL::EXPRESSION_STRING:
+		case HPL::EXPRESSION_FSTRING:
+		case HPL::EXPRESSION_BOOL:
+			if (!autoType && var.type != v.var.type)
+				break;
+
+			var.type = v.var.type;
+			var.value = std::move(v.var.value);
+			return true;
+
+		case HPL::EXPRESSION_NUMBER:
+			if (autoType)
+				var.type = v.var.type;
+
+			if (var.type == v.var.type)
+				var.value = std::move(v.var.value);
+			else if (var.type == HPL::constants[v.source->constant].other.type)
+				var.value = HPL::constants[v.source->constant].other.value;
+			else
+				break;
+
+			return true;
+
+		case HPL::EXPRESSION_CALL:
+			if (autoType)
+				var.type.clear();
+
+			assignOutputToVar(&var, v.source->name, v.returnType, v.var);
+			return true;
+
+		default:
+			break;
+	}
+
+	return evaluateExpression(var, *v.source, onlyChangeValue);
+}
+
+
+// Turns the value into a variable of its own type.
+static HPL::variable toVariable(stackValue& v, const char* error) {
+	HPL::variable var;
+
+	if (!storeValue(var, v, false))
+		HPL::throwError(true, error, v.source->text.c_str());
+
+	return var;
+}
+
+
+// Finds the variable of the site, either from its slot or by its name.
+static HPL::variable* findVariable(const HPL::site& s, size_t base, std::vector<signed char>& shadowed, bool write = false) {
+	if (s.slot == -1)
+		return getVarFromName(s.name, s.members, write);
+
+	if ((size_t)s.slot >= shadowed.size())
+		shadowed.resize(s.slot + 1, -1);
+
+	if (shadowed[s.slot] == -1)
+		shadowed[s.slot] = HPL::variables.existsBefore(HPL::variables[base + s.slot].name, base);
+
+	if (shadowed[s.slot])
+		return getVarFromName(s.name, write);
+
+	HPL::variable& var = HPL::variables[base + s.slot];
+
+	if (!s.members.path.empty())
+		return getMember(var, s.members, write);
+
+	setStructDefaults(var);
+	return &var;
+}
+
+
+// Removes the block's variables, the same way that the tree-walker does.
+static void endBlock(std::vector<size_t>& blocks) {
+	HPL::variables.endBlock(blocks.back());
+	blocks.pop_back();
+
+	if (HPL::arg.debugAll || HPL::arg.debugLog)
+		HPL::arg.curIndent.pop_back();
+}
+
+
+// Ends the blocks of the current function, while the ones of the functions that it returns for stay.
+static void endBlocks(std::vector<size_t>& blocks, const std::vector<tailCall>& tails) {
+	size_t own = (tails.empty() ? 0 : tails.back().blocks);
+
+	while (blocks.size() > own)
+		endBlock(blocks);
+}
+
+
+void HPL::runChunk(const chunk& program, size_t base/* = 0*/, bool alreadyRead/* = false*/, size_t start/* = 0*/) {
+	const chunk* code = &program;
+	std::vector<stackValue> stack;
+	std::vector<size_t> blocks;
+	std::vector<signed char> shadowed; // If the slot is shadowed, or -1 if it wasn't checked yet.
+	bool res = false, group = true; // Same as in 'interpreteCondition'.
+	bool log = (arg.debugAll || arg.debugLog);
+	arena::scope temporaries(scratch); // Rewound at every line, just like the tree-walker does after each statement.
+	arena::marker lineStart = temporaries.start;
+
+	std::vector<frame> callers; // The functions that are waiting for a call to return, from the oldest.
+	std::vector<tailCall> tails; // The functions that the current one returns for, from the oldest.
+	pendingCall running;        // The call that started the current function.
+
+	// Finishes the current function and continues its caller with the output.
+	auto returnToCaller = [&]() {
+		atom type = functions[running.function].type;
+		variable output;
+		endCall(running, output);
+
+		// The function that returns the output goes on from its 'return', which also finishes it.
+		if (!tails.empty()) {
+			tailCall& caller = tails.back();
+			const site& s = *caller.call;
+
+			code = caller.code;
+			base = caller.base;
+			stack.clear();
+			shadowed.clear();
+			res = caller.res;
+			group = caller.group;
+			scratch.rewind(lineStart);
+			lineStart = caller.temporaries;
+			running = std::move(caller.running);
+			size_t pc = caller.pc;
+			tails.pop_back();
+
+			stack.push_back({std::move(output), s.value, false, type});
+			return pc;
+		}
+
+		frame& caller = callers.back();
+		const site& s = *caller.call;
+
+		code = caller.code;
+		base = caller.base;
+		stack = std::move(caller.stack);
+		blocks = std::move(caller.blocks);
+		shadowed = std::move(caller.shadowed);
+		tails = std::move(caller.tails);
+		res = caller.res;
+		group = caller.group;
+		scratch.rewind(lineStart);
+		lineStart = caller.temporaries;
+		running = std::move(caller.running);
+		size_t pc = caller.pc;
+		callers.pop_back();
+
+		stack.push_back({std::move(output), s.value, false, type});
+		return pc;
+	};
+
+	for (size_t pc = start; ; pc++) {
+		if (pc >= code->code.size()) {
+			if (callers.empty() && tails.empty())
+				return;
+
+			pc = returnToCaller(); // The function ended without returning anything.
+			continue;
+		}
+
+		const instruction& in = code->code[pc];
+
+		switch (in.op) {
+			case OP_LINE:
+				if (!arg.interprete)
+					return;
+
+				lineCount = in.a;
+				scratch.rewind(lineStart);
+
+				if (arg.breakpoint && curFile == arg.breakpointValues.first && lineCount == arg.breakpointValues.second) {
+					std::cout << "Breakpoint reached at " << curFile << ":" << lineCount << std::endl;
+					arg.interprete = false;
+					return;
+				}
+				break;
+
+			case OP_NODE:
+				interpreteNode(*code->sites[in.a].statement);
+
+				if (!arg.interprete)
+					return;
+
+				if (code->sites[in.a].statement->type == NODE_FOR && functionOutput.has_value()) { // Returned inside of the loop.
+					endBlocks(blocks, tails);
+
+					if (code->isFunction) {
+						if (callers.empty() && tails.empty())
+							return;
+
+						pc = returnToCaller();
+						break;
+					}
+
+					pc = in.b - 1;
+				}
+				break;
+
+			case OP_READ_ONCE:
+				if (alreadyRead) // Since we already read the file, just don't do it.
+					return;
+				break;
+
+			case OP_CONSTANT:
+				stack.push_back({constants[in.a].value, code->sites[in.b].value});
+				break;
+
+			case OP_EXPRESSION:
+				stack.push_back({{}, code->sites[in.a].value, true});
+				break;
+
+			case OP_LOAD_LOCAL:
+			case OP_LOAD_MEMBER:
+			case OP_LOAD_NAME: {
+				const site& s = code->sites[in.a];
+				variable* var = findVariable(s, base, shadowed);
+
+				if (var != nullptr)
+					stack.push_back({*var, s.value});
+				else // Let 'evaluateExpression' figure out what it is instead.
+					stack.push_back({{}, s.value, true});
+				break;
+			}
+
+			case OP_FSTRING: {
+				const site& s = code->sites[in.a];
+				std::string value = s.value->text.substr(1); // Remove the F letter.
+
+				for (int i = 0; i < in.b; i++) {
+					auto& v = stack[stack.size() - in.b + i];
+					auto var = toVariable(v, "Argument '%s' is invalid (Either it's a variable that doesn't exist or something else entirely)");
+
+					value = replaceOnce(value, "{" + s.value->args[i].text + "}", xToStr(var.value));
+				}
+				stack.resize(stack.size() - in.b);
+
+				stack.push_back({{.type = HPL::atom::STRING, .value = joinStrings(value)}, s.value});
+				break;
+			}
+
+			case OP_CALL: {
+				const site& s = code->sites[in.a];
+				std::vector<variable> params;
+				bool organizeParams = false;
+
+				if (s.statement != nullptr && log)
+					std::cout << arg.curIndent << "LOG: [USE][FUNCTION]: " << curFile << ":" << lineCount << ": <name>(<params>): " << s.value->text << std::endl;
+
+				if (log)
+					arg.curIndent += "\t";
+
+				for (int i = 0; i < in.b; i++) {
+					auto& v = stack[stack.size() - in.b + i];
+
+					if (!s.named[i].empty())
+						organizeParams = true;
+					else if (organizeParams)
+						throwError(true, "All out of order argument initializations must be accompanied with the name of the param (format is '%s', not just '%s')", "<param> = <value>", v.source->text.c_str());
+
+					variable var = toVariable(v, "Variable '%s' doesn't exist (Cannot use a variable that doesn't exist).");
+
+					if (organizeParams)
+						var.name = s.named[i];
+					else
+						startOrgAt++;
+
+					if (log)
+						std::cout << arg.curIndent << "LOG: [FIND][PARAM]: " << curFile << ":" << lineCount << ": <type> <name> = <value>: " << printVar(var) << std::endl;
+
+					params.push_back(std::move(var));
+				}
+				stack.resize(stack.size() - in.b);
+
+				pendingCall call;
+				variable output;
+				beginCall(s.function, params, organizeParams, call, output);
+
+				if (!arg.interprete)
+					return;
+
+				if (call.function == -1) { // Core functions are already done.
+					atom type = output.type;
+					stack.push_back({std::move(output), s.value, false, type});
+					break;
+				}
+
+				// A call whose output gets returned right away takes over the caller's frame. The caller's
+				// variables and blocks are kept, since the function can still read them by their names.
+				if (code->isFunction && stack.empty() && pc + 1 < code->code.size() && code->code[pc + 1].op == OP_RETURN) {
+					tails.push_back({code, pc, base, blocks.size(), res, group, lineStart, &s, std::move(running)});
+					shadowed.clear();
+				}
+				else {
+					callers.push_back({code, pc, base, std::move(stack), std::move(blocks), std::move(shadowed), std::move(tails), res, group, lineStart, &s, std::move(running)});
+					stack.clear();
+					blocks.clear();
+					shadowed.clear();
+					tails.clear();
+				}
+
+				running = std::move(call);
+				base = running.base;
+				lineStart = scratch.mark();
+
+				code = &compileFunction(*functions[running.function].definition);
+				res = false;
+				group = true;
+
+				pc = -1; // Starts from the function's first instruction.
+				break;
+			}
+
+			case OP_POP:
+				stack.pop_back();
+				break;
+
+			case OP_DECLARE: {
+				const site& s = code->sites[in.a];
+				variable var = {.type = s.statement->valueType, .name = s.statement->names[in.b]};
+				structure* _struct = nullptr;
+
+				if (!typeIsValid(var.type, _struct)) // Type isn't cored or a structure.
+					throwError(true, "Type '%s' doesn't exist (Cannot init a variable without valid type).", var.type.c_str());
+
+				if (!storeValue(var, stack.back(), true) && s.value->type != EXPRESSION_EMPTY)
+					throwError(true, "Variable '%s' doesn't exist (Cannot copy value from something that doesn't exist).", s.value->text.c_str());
+				stack.pop_back();
+
+				variables.push_back(std::move(var));
+
+				if (log)
+					std::cout << arg.curIndent << "LOG: [CREATE][VARIABLE]: " << curFile << ":" << lineCount << ": <type> <variable> = [value]: " << printVar(variables.back()) << std::endl;
+				break;
+			}
+
+			case OP_ASSIGN: {
+				const site& s = code->sites[in.a];
+				variable* var = findVariable(s, base, shadowed, true);
+
+				if (var == nullptr)
+					throwError(true, "Variable '%s' doesn't exist (Can't edit a variable that doesn't exist)", s.statement->name.c_str());
+
+				if (stack.back().source != nullptr)
+					storeValue(*var, stack.back(), true);
+				stack.pop_back();
+
+				if (log)
+					std::cout << arg.curIndent << "LOG: [EDIT][VARIABLE]: " << curFile << ":" << lineCount << ": <type> <variable> = <value>: " << printVar(*var) << std::endl;
+				break;
+			}
+
+			case OP_GUARD: {
+				const site& s = code->sites[in.a];
+				const expression& value = s.statement->values[0];
+				bool isReturn = (s.statement->type == NODE_RETURN);
+				variable* var = (isReturn ? &functionOutput : findVariable(s, base, shadowed, true));
+
+				if (var == nullptr)
+					throwError(true, "Variable '%s' doesn't exist (Can't edit a variable that doesn't exist)", s.statement->name.c_str());
+
+				if (var->type == HPL::atom::BOOL || var->type == HPL::atom::SCOPE || var->type == HPL::atom::STRUCT) {
+					evaluateExpression(*var, value, !isReturn);
+
+					stack.push_back({}); // Already stored.
+					pc = in.b - 1;
+				}
+				break;
+			}
+
+			case OP_MATH: {
+				const site& s = code->sites[in.a];
+				variable value;
+				bool found = true;
+
+				if (in.b) {
+					found = storeValue(value, stack.back(), false);
+					stack.pop_back();
+				}
+
+				variable* var = findVariable(s, base, shadowed, true);
+
+				if (var == nullptr)
+					throwError(true, "Cannot perform any math operations to this variable (Variable '%s' does not exist).", s.statement->name.c_str());
+
+				if (!found && var->type != HPL::atom::STRING)
+					throwError(true, "Variable '%s' doesn't exist (Cannot perform math with something that doesn't exist).", s.statement->values[0].text.c_str());
+
+				doMath(*var, s.statement->_operator, (in.b ? &value : nullptr));
+
+				if (log) {
+					std::cout << arg.curIndent << "LOG: [MATH][VARIABLE]: " << curFile << ":" << lineCount << ": <variable> <operator> [value]: " << var->name << " " << s.statement->_operator;
+					if (in.b)
+						std::cout << " " << s.statement->values[0].text;
+					std::cout << std::endl;
+				}
+				break;
+			}
+
+			case OP_RETURN:
+				if (stack.back().source != nullptr)
+					storeValue(functionOutput, stack.back(), false);
+				stack.pop_back();
+
+				if (log)
+					std::cout << arg.curIndent << "LOG: [FOUND][RETURN]: " << curFile << ":" << lineCount << ": return <value> (<type>): return " << xToStr(functionOutput.value) << " (" << functionOutput.type << ")" << std::endl;
+
+				if (functionOutput.has_value()) { // Returned something, so every block stops.
+					endBlocks(blocks, tails);
+
+					if (code->isFunction) {
+						if (callers.empty() && tails.empty())
+							return;
+
+						pc = returnToCaller();
+						break;
+					}
+
+					pc = in.b - 1;
+				}
+				break;
+
+			case OP_TRUTHY: {
+				auto var = toVariable(stack.back(), "Variable '%s' doesn't exist (Cannot check the value from something that doesn't exist).");
+				std::string value = xToStr(var.value);
+				stack.pop_back();
+
+				if (log)
+					std::cout << arg.curIndent << "LOG: [CHECKING][IF-STATEMENT-VALUE]: " << curFile << ":" << lineCount << ": <value> ([type]): " << value << " (" << var.type << ")" << std::endl;
+
+				group = group && !(value == "false" || value == "0");
+				break;
+			}
+
+			case OP_COMPARE: {
+				const std::string& _operator = code->sites[in.a].name;
+				std::string value = xToStr(toVariable(stack[stack.size() - 2], "Variable '%s' doesn't exist (Cannot check the value from something that doesn't exist).").value);
+				std::string value2 = xToStr(toVariable(stack.back(), "Variable '%s' doesn't exist (Cannot check the value from something that doesn't exist).").value);
+				stack.resize(stack.size() - 2);
+
+				bool output = compareValues(value, _operator, value2);
+
+				if (log)
+					std::cout << arg.curIndent << "LOG: [OPERATOR][RELATION]: " << curFile << ":" << lineCount << ": <value 1> <operator> <value 2>: " << value << " " << _operator << " " <<  value2 << " (" << (output == true ? "true" : "false") << ")" << std::endl;
+
+				group = group && output;
+				break;
+			}
+
+			case OP_OR:
+				res = res || group;
+				group = true;
+				break;
+
+			case OP_JUMP_IF_FALSE: {
+				bool output = res || group;
+				res = false;
+				group = true;
+
+				if (log) {
+					std::string condition;
+					for (const auto& v : code->sites[in.b].statement->values)
+						condition += (condition.empty() ? "" : " ") + v.text;
+
+					std::cout << arg.curIndent << "LOG: [FOUND][IF-STATEMENT]: " << curFile << ":" << lineCount << ": if (<condition>): if (" << condition << ")" << std::endl;
+
+					if (output)
+						arg.curIndent += "\t";
+					else
+						std::cout << arg.curIndent << "LOG: [FAILED][IF-STATEMENT]: " << curFile << ":" << lineCount << ": Condition failed, output returned false." << std::endl;
+				}
+
+				if (!output)
+					pc = in.a - 1;
+				break;
+			}
+
+			case OP_BLOCK_BEGIN:
+				blocks.push_back(variables.size());
+				break;
+
+			case OP_BLOCK_END:
+				endBlock(blocks);
+
+				if (shadowed.size() > variables.size() - base)
+					shadowed.resize(variables.size() - base);
+				break;
+		}
+	}
+}
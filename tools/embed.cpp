@@ -0,0 +1,98 @@
+/*
+* Copyright (C) 2022-2023 EimaMei/Sacode
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+*    claim that you wrote the original software. If you use this software
+*    in a product, an acknowledgment in the product documentation would be
+*    appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+*    misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*
+*
+*/
+
+// Builds the core libraries into the executable. Every file that's given gets
+// parsed and printed out as C++ along with its '.hplc' cache, which then gets
+// compiled together with the rest of HPL.
+
+#include <interpreter.hpp>
+#include <parser.hpp>
+#include <cache.hpp>
+#include <corelib.hpp>
+
+#include <filesystem>
+#include <iostream>
+#include <string_view>
+
+
+// The embedder itself doesn't have any core libraries built in, so it always reads them from the disk.
+const HPL::coreLibrary HPL::coreLibraries[] = {{}};
+const size_t HPL::coreLibraryCount = 0;
+
+
+// Prints the data as a string literal, with everything that isn't plainly printable escaped.
+static void printString(const std::string& name, std::string_view data) {
+	std::cout << "static const char " << name << "[] =\n\t\"";
+
+	for (size_t i = 0; i < data.size(); i++) {
+		unsigned char c = data[i];
+
+		if (c == '\\' || c == '"')
+			std::cout << '\\' << c;
+		else if (c >= ' ' && c <= '~')
+			std::cout << c;
+		else // Always 3 digits, so the next character can't become a part of it.
+			std::cout << '\\' << (char)('0' + (c >> 6)) << (char)('0' + ((c >> 3) & 7)) << (char)('0' + (c & 7));
+
+		if (c == '\n' && i + 1 < data.size())
+			std::cout << "\"\n\t\"";
+	}
+
+	std::cout << "\";\n\n";
+}
+
+
+int main(int argc, char** argv) {
+	std::cout << "// Generated by 'tools/embed.cpp', don't edit it.\n"
+				 "#include <corelib.hpp>\n\n";
+
+	for (int i = 1; i < argc; i++) {
+		HPL::program prog;
+		prog.file = argv[i];
+		HPL::curFile = prog.file;
+
+		if (!prog.mapping.open(prog.file)) {
+			std::cerr << HPL::colorText("Error: ", HPL::OUTPUT_RED) << HPL::colorText(prog.file, HPL::OUTPUT_RED) << ": No such file or directory" << std::endl;
+			return -1;
+		}
+
+		prog.source = std::string_view(prog.mapping.data, prog.mapping.size);
+		HPL::parseProgram(prog);
+
+		printString("source" + std::to_string(i), prog.source);
+		printString("cache" + std::to_string(i), HPL::writeCache(prog));
+	}
+
+	std::cout << "const HPL::coreLibrary HPL::coreLibraries[] = {\n";
+
+	for (int i = 1; i < argc; i++) {
+		std::string id = std::to_string(i);
+		std::cout << "\t{\"" << std::filesystem::path(argv[i]).filename().string() << "\", "
+				  << "{source" << id << ", sizeof(source" << id << ") - 1}, "
+				  << "{cache" << id << ", sizeof(cache" << id << ") - 1}},\n";
+	}
+
+	std::cout << "\t{}\n};\n"
+				 "const size_t HPL::coreLibraryCount = " << argc - 1 << ";\n";
+
+	return 0;
+}